@@ -0,0 +1,36 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <vector>
+
+#include "AssetPackFormat.hpp"
+
+// Procitan (mmap) .swpak paket koji pravi tools/swpak. Texeli se salju u GL direktno iz mapirane
+// memorije, bez dekodiranja i bez kopije na heap-u. Ako paketa nema ili je unos zastareo,
+// pozivaoci se vracaju na PNG.
+class AssetPack {
+public:
+    AssetPack();
+
+    bool open(const char* path);
+    void close();
+    bool isOpen() const { return data_ != nullptr; }
+
+    // nullptr ako slike nema u paketu ili je izvorni PNG menjan posle pakovanja
+    const SwpakEntry* find(const char* name) const;
+
+    const unsigned char* levelData(const SwpakEntry& entry, unsigned level) const { return data_ + entry.offset[level]; }
+
+    // Salje sve nivoe unosa u teksturu vezanu na GL_TEXTURE_2D
+    void uploadTexture2D(const SwpakEntry& entry) const;
+
+private:
+    const unsigned char* data_;
+    std::size_t size_;
+    bool mapped_;
+    std::vector<unsigned char> buffer_; // bez mmap-a (ne-POSIX) fajl se cita ovde
+};
+
+// Paket koji koriste loadImageToTexture i TextureLoader; otvara ga main pre init-a
+AssetPack& assetPack();
\ No newline at end of file
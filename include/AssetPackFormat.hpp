@@ -0,0 +1,48 @@
+#pragma once
+
+// Format .swpak fajla - deli ga alat tools/swpak i runtime (AssetPack).
+//
+//   SwpakHeader
+//   SwpakEntry[entryCount]
+//   texel podaci (svaki mip nivo poravnat na SWPAK_ALIGNMENT)
+//
+// Texeli su vec okrenuti (prvi red je donji, kao posle stbi__vertical_flip) i gusto spakovani
+// (channels bajtova po pikselu, bez poravnanja redova), pa idu pravo u glTexImage2D.
+// Svi brojevi su little-endian.
+
+#include <cstdint>
+
+static const char SWPAK_MAGIC[4] = { 'S', 'W', 'P', 'K' };
+static const std::uint32_t SWPAK_VERSION = 2;
+static const std::uint32_t SWPAK_ALIGNMENT = 16;
+static const int SWPAK_MAX_NAME = 96;
+static const int SWPAK_MAX_LEVELS = 16;
+
+// SwpakEntry::flags
+static const std::uint32_t SWPAK_FLAG_MASK = 1; // jednobojna RGBA slika sacuvana kao alfa (channels == 1), boja u maskColor
+
+struct SwpakHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t entryCount;
+    std::uint32_t reserved;
+};
+
+struct SwpakEntry {
+    char name[SWPAK_MAX_NAME];  // putanja izvorne slike, npr. "res/ekg.png"
+    std::uint32_t channels;     // 1 (GL_R8) ili 4 (GL_RGBA8)
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t levels;       // broj mip nivoa, 1 = bez mipmapa
+    std::uint32_t flags;
+    std::uint8_t maskColor[4];  // RGB (+ 0) za SWPAK_FLAG_MASK
+    std::uint64_t sourceSize;   // velicina i vreme izmene izvorne slike - zastareo unos se preskace
+    std::int64_t sourceMtime;
+    std::uint64_t offset[SWPAK_MAX_LEVELS]; // od pocetka fajla
+};
+
+// Dimenzija mip nivoa, kao u GL-u
+inline std::uint32_t swpakLevelSize(std::uint32_t size, std::uint32_t level) {
+    std::uint32_t s = size >> level;
+    return s ? s : 1;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+
+// Generisano alatom tools/atlas_packer (make atlas) - ne menjati rucno.
+
+struct AtlasRegion {
+    int page;
+    float u0, v0, u1, v1; // UV u atlasu, v = 0 je dno (slike se ucitavaju okrenute)
+    float x0, y0, x1, y1; // deo originalne slike koji je ostao posle odsecanja, 0..1
+    float r, g, b;        // boja sprite-a na jednokanalnoj strani (maska); 1 na RGBA stranama
+};
+
+enum class SpriteId {
+    ArrowLeft,
+    ArrowRight,
+    Heart,
+    BatteryFrame,
+    IdOverlay,
+    WarningFull,
+    Count
+};
+
+static const int kAtlasPageCount = 2;
+
+static const char* const kAtlasPages[kAtlasPageCount] = {
+    "res/atlas0.png",
+    "res/atlas1.png",
+};
+
+// 4 = RGBA8, 1 = maska (GL_R8, pokrivenost u crvenom kanalu)
+static const int kAtlasPageChannels[kAtlasPageCount] = { 4, 1 };
+
+static const AtlasRegion kAtlasRegions[static_cast<int>(SpriteId::Count)] = {
+    { 1, 0.003472f, 0.517857f, 0.447917f, 0.995536f, 0.000000f, 0.082031f, 1.000000f, 0.917969f, 0.000000f, 0.000000f, 0.000000f }, // res/arrow_left.png
+    { 1, 0.003472f, 0.031250f, 0.447917f, 0.508929f, 0.000000f, 0.082031f, 1.000000f, 0.917969f, 0.000000f, 0.000000f, 0.000000f }, // res/arrow_right.png
+    { 1, 0.454861f, 0.504464f, 0.899306f, 0.995536f, 0.000000f, 0.070312f, 1.000000f, 0.929688f, 0.000000f, 0.000000f, 0.000000f }, // res/heart.png
+    { 1, 0.454861f, 0.183036f, 0.899306f, 0.495536f, 0.000000f, 0.226562f, 1.000000f, 0.773438f, 0.000000f, 0.000000f, 0.000000f }, // res/battery_frame.png
+    { 0, 0.002404f, 0.460938f, 0.948317f, 0.984375f, 0.139854f, 0.115702f, 0.859232f, 0.669421f, 1.000000f, 1.000000f, 1.000000f }, // res/id_overlay.png
+    { 0, 0.002404f, 0.054688f, 0.844952f, 0.429688f, 0.144162f, 0.289256f, 0.855838f, 0.685950f, 1.000000f, 1.000000f, 1.000000f }, // res/warning_full.png
+};
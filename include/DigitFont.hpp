@@ -0,0 +1,58 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <vector>
+
+#include "ShaderProgram.hpp"
+#include "TextureLoader.hpp"
+
+// Glifovi kao signed distance field slojevi jedne GL_TEXTURE_2D_ARRAY teksture:
+// slojevi 0-9 su cifre, zatim dvotacka i procenat (res/sdf, generisano sa "make sdf").
+// drawNumber/drawGlyph samo dodaju instance; flush() iscrtava sve iz frejma jednim glDrawArraysInstanced.
+enum class Glyph {
+    Colon = 10,
+    Percent = 11
+};
+
+class DigitFont {
+public:
+    DigitFont();
+
+    // SDF slojevi se ucitavaju preko loader-a; spremni su kada je resident(texture())
+    bool init(const ShaderProgram& shader, TextureLoader& loader, int priority);
+    GLuint texture() const { return texture_; }
+    void destroy();
+
+    // (x, y) je centar prve (krajnje leve) cifre, cifre su razmaknute za spacing;
+    // digitW/digitH su polu-dimenzije kao kod SpriteBatch::draw. minDigits dopunjuje nulama (npr. 05).
+    // Glifovi su jednobojni - (r, g, b, a) je njihova boja, podrazumevano crna kao u originalnim slikama.
+    void drawNumber(int value, float x, float y, float digitW, float spacing,
+                    float digitH, int minDigits = 1,
+                    float r = 0.0f, float g = 0.0f, float b = 0.0f, float a = 1.0f);
+
+    void drawGlyph(Glyph glyph, float x, float y, float w, float h,
+                   float r = 0.0f, float g = 0.0f, float b = 0.0f, float a = 1.0f);
+
+    void flush();
+
+    int lastDrawCalls() const { return lastDrawCalls_; }
+
+private:
+    void addInstance(int layer, float x, float y, float w, float h, float r, float g, float b, float a);
+
+    struct Instance {
+        float x, y, w, h;
+        float layer;
+        float r, g, b, a;
+    };
+
+    ShaderProgram shader_;
+    GLuint texture_;
+    GLuint VAO_;
+    GLuint quadVBO_;
+    GLuint instanceVBO_;
+    std::size_t instanceCapacity_;
+    int lastDrawCalls_;
+
+    std::vector<Instance> instances_;
+};
\ No newline at end of file
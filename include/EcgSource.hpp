@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "SpscRing.hpp"
+
+// Jedan EKG uzorak: vreme izvora u sekundama i napon u mV
+struct EcgSample {
+    double time;
+    float value;
+};
+
+typedef SpscRing<EcgSample> EcgRing;
+
+// Nit koja cita EKG uzorke (250-1000 Hz) iz fajla, FIFO-a ili lokalnog socketa ("unix:/putanja")
+// i gura ih u EcgRing ka simulaciji. Format je tekst, uzorak po redu: "vreme vrednost" (razmak ili
+// zarez); prazni redovi i redovi sa # se preskacu. Obican fajl se pusta tempom svojih vremena,
+// kao da stize sa senzora; FIFO-u i socketu tempo daje pisac.
+// Podrzano na POSIX sistemima; drugde start vraca false.
+class EcgReader {
+public:
+    EcgReader();
+    ~EcgReader(); // zaustavlja nit
+
+    bool start(const char* source, EcgRing& ring);
+    void stop();
+
+    bool running() const { return thread_.joinable(); }
+
+    // Izvor je zatvoren ili procitan do kraja (bilo koja nit)
+    bool finished() const { return finished_.load(std::memory_order_acquire); }
+
+    std::uint64_t samplesRead() const { return samples_.load(std::memory_order_relaxed); }
+    std::uint64_t malformed() const { return malformed_.load(std::memory_order_relaxed); }
+
+    // Procitano, odbaceno zbog punog prstena, neispravni redovi i da li je izvor vec zatvoren
+    void printStats() const;
+
+private:
+    void readerLoop();
+    bool parseLine(const char* line, EcgSample& outSample);
+    bool waitUntil(double sampleTime); // tempo obicnog fajla; false ako je zatrazeno zaustavljanje
+
+    EcgRing* ring_;
+    std::thread thread_;
+    int fd_;
+    int stopPipe_[2];
+    bool paced_;
+    double firstSampleTime_;
+    double startWall_;
+
+    // Pise samo nit citaca, bez atomicnog sabiranja
+    std::atomic<bool> finished_;
+    std::atomic<std::uint64_t> samples_;
+    std::atomic<std::uint64_t> malformed_;
+};
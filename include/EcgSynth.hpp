@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "EcgSource.hpp"
+
+struct EcgSynthParams {
+    double sampleRate = 500.0;
+    double bpm = 70.0;
+    double hrv = 0.03;         // slucajno odstupanje R-R intervala (SD, sekunde)
+    double respiration = 0.25; // ucestanost disanja (Hz)
+    double rsa = 0.04;         // respiratorna aritmija: amplituda kao udeo R-R intervala
+    float noise = 0.01f;       // beli sum (SD, mV)
+    float wander = 0.05f;      // lutanje osnovne linije sa disanjem (mV)
+    unsigned seed = 0;
+};
+
+// Vestacki EKG kao zbir Gausovih talasa (P, Q, R, S, T) oko svakog R zupca, po uzoru na
+// McSharry-jev model. Razmaci P-R i R-T skaliraju se sa sqrt(RR) (Bazett), a sirine talasa su
+// iste pri svakom BPM-u, pa oblik ostaje verodostojan i na 220 BPM (P se tada naslanja na T).
+// R-R intervali nose RSA (disanje) i slucajnu varijabilnost. Isto seme i isti pozivi daju iste
+// uzorke - sluzi kao izvor traga kada nema senzora i kao deterministicko opterecenje za
+// QrsDetector (jedan sintetizator po virtuelnom pacijentu).
+class EcgSynth {
+public:
+    EcgSynth();
+
+    // Prvi uzorak je u startTime; prvi R zubac dolazi posle pola R-R intervala
+    void init(const EcgSynthParams& params, double startTime = 0.0);
+
+    // Vazi od sledeceg zakazanog otkucaja
+    void setBpm(double bpm) { params_.bpm = bpm; }
+
+    void generate(float* outValues, std::size_t count);
+    void generate(EcgSample* outSamples, std::size_t count);
+
+    // Preskace do time bez racunanja uzoraka; otkucaji krecu iznova od tog trenutka
+    void skipTo(double time);
+
+    // Vreme sledeceg uzorka
+    double time() const { return startTime_ + static_cast<double>(index_) / params_.sampleRate; }
+
+    double sampleRate() const { return params_.sampleRate; }
+    // R zupci do time()
+    std::uint64_t beats() const { return beats_; }
+
+    // Stvarni prosek svih zakazanih R-R intervala (0 pre prvog)
+    double meanBpm() const { return rrSum_ > 0.0 ? 60.0 * rrCount_ / rrSum_ : 0.0; }
+
+private:
+    // Poslednji prosli i dva sledeca R zupca; talasi daljih otkucaja ne doprinose
+    static const int BEATS = 3;
+
+    struct Beat {
+        double time;
+        double scale; // sqrt(RR) prethodnog intervala
+    };
+
+    float sample(double time);
+    void scheduleBeat();
+    void resetBeats(double time);
+
+    EcgSynthParams params_;
+    double startTime_;
+    std::uint64_t index_;
+    Beat rPeaks_[BEATS];
+    std::uint64_t beats_;
+    double rrSum_;
+    std::uint64_t rrCount_;
+
+    std::mt19937 rng_;
+    std::normal_distribution<double> gauss_;
+};
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "EcgSource.hpp"
+#include "ShaderProgram.hpp"
+
+// EKG trag kao anti-aliased linija kroz stvarne uzorke (shaders/trace.vert + trace.frag).
+// Uzorci idu u prstenasti VBO od CAPACITY mesta i upisuju se samo jednom, kada stignu; svaki
+// segment je jedna instanca koja cita dva susedna uzorka, a pomeranje traga je samo uniform
+// sa vremenom desne ivice. Prvo mesto se ponavlja iza poslednjeg, pa i segment preko kraja
+// prstena cita susedne uzorke.
+// Sa GL 4.4 / ARB_buffer_storage bafer je trajno mapiran; inace se novi opseg mapira bez
+// sinhronizacije. Oba su bezbedna jer GPU cita samo vidljivi deo, a prsten je dosta duzi od
+// njega - novi uzorci nikad ne prepisuju ono sto se jos crta.
+class EkgTrace {
+public:
+    // 8 s na 1 kHz; vidljivi prozor mora da bude znatno kraci
+    static const int CAPACITY = 8192;
+
+    EkgTrace();
+
+    bool init(const ShaderProgram& shader);
+    void destroy();
+
+    // Uzorci redom po vremenu; salju se na GPU odmah
+    void append(const EcgSample* samples, std::size_t count);
+
+    // Ima li uzoraka novijih od time - window
+    bool visible(double time, double window) const;
+
+    // Trag u pravougaoniku (centar, polu-dimenzije u NDC): desna ivica je time, leva
+    // time - window; vrednosti minValue..maxValue (mV) idu od donje do gornje ivice.
+    // viewportW/H je velicina cilja u pikselima (za debljinu linije).
+    void draw(double time, double window, float x, float y, float w, float h,
+              float minValue, float maxValue, int viewportW, int viewportH,
+              float r, float g, float b, float a);
+
+private:
+    struct Vertex {
+        float time;  // vreme uzorka po modulu TIME_WRAP
+        float value;
+    };
+
+    void write(std::size_t slot, const Vertex* vertices, std::size_t count);
+
+    // Logicki indeks prvog uzorka novijeg od time (binarna pretraga po prstenu)
+    std::uint64_t firstAfter(double time) const;
+
+    ShaderProgram shader_;
+    UniformFloat uTime_;
+    UniformFloat uWrap_;
+    UniformFloat uWindow_;
+    UniformVec4 uRect_;
+    UniformVec2 uRange_;
+    UniformVec2 uViewport_;
+    UniformFloat uWidth_;
+    UniformVec4 uColor_;
+
+    GLuint VAO_;
+    GLuint VBO_;
+    Vertex* mapped_; // trajno mapiran bafer; nullptr - mapira se po upisu
+
+    std::vector<double> times_; // tacna vremena po mestu, za izbor vidljivog opsega
+    std::uint64_t written_;
+};
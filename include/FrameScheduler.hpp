@@ -0,0 +1,59 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+
+// Kako glavna petlja ceka sledeci frejm
+enum class FramePolicy {
+    OnDemand, // glfwWaitEventsTimeout - budi se na dogadjaj ili kada aplikaciji zatreba novi frejm
+    VSync,    // swap interval 1 - tempo diktira glfwSwapBuffers
+    Deadline  // apsolutni rokovi na fiksnom koraku, spavanje bez vrtenja (clock_nanosleep na Linux-u);
+              // kada nema animacije ceka dogadjaj kao OnDemand
+};
+
+// "ondemand", "vsync" ili "deadline"
+bool parseFramePolicy(const char* name, FramePolicy& outPolicy);
+const char* framePolicyName(FramePolicy policy);
+
+// Statistika razmaka izmedju iscrtanih frejmova (u sekundama)
+struct FrameStats {
+    unsigned long wakeups = 0;   // koliko puta se petlja probudila
+    unsigned long presented = 0; // koliko je frejmova zaista iscrtano
+    double meanInterval = 0.0;
+    double m2 = 0.0;             // Welford - suma kvadrata odstupanja od srednje vrednosti
+    double minInterval = 0.0;
+    double maxInterval = 0.0;
+    double maxLateness = 0.0;    // najvece kasnjenje budjenja u odnosu na zakazano vreme
+
+    double jitter() const; // standardna devijacija razmaka
+};
+
+class FrameScheduler {
+public:
+    FrameScheduler();
+
+    // frameTime je najkraci razmak izmedju frejmova; za VSync sluzi samo kao gornja granica cekanja
+    void init(FramePolicy policy, double frameTime);
+
+    // Ceka sledeci frejm i obradjuje dogadjaje. idleTimeout je koliko aplikacija moze da miruje
+    // bez dogadjaja (0 ako se nesto animira); ispod frameTime se ne ide.
+    void waitForFrame(double idleTimeout);
+
+    // Poziva se posle render(); presented je true ako je frejm iscrtan i zamenjen
+    void frameDone(bool presented);
+
+    FramePolicy policy() const { return policy_; }
+    const FrameStats& stats() const { return stats_; }
+    void printStats() const;
+
+private:
+    void sleepUntil(double deadline);
+
+    FramePolicy policy_;
+    double frameTime_;
+    double deadline_;
+    double scheduledWake_;
+    double lastPresent_;
+    bool lastPresented_;
+    FrameStats stats_;
+};
\ No newline at end of file
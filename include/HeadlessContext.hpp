@@ -0,0 +1,16 @@
+#pragma once
+
+// OpenGL 3.3 core kontekst bez prozora i displeja (EGL surfaceless, npr. Mesa llvmpipe).
+// Nema podrazumevanog framebuffer-a - pozivalac crta u sopstveni FBO (createRenderTarget).
+// Podrzano samo na Linux-u; na ostalim platformama init vraca false.
+class HeadlessContext {
+public:
+    HeadlessContext();
+
+    bool init();
+    void destroy();
+
+private:
+    void* display_;
+    void* context_;
+};
\ No newline at end of file
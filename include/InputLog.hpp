@@ -0,0 +1,83 @@
+#pragma once
+
+// Snimak jednog pokretanja (--record) koji --replay pusta bez prozora i bez cekanja:
+//
+//   InputLogHeader
+//   zapisi: tip (1 bajt) + podaci, redom kojim ih je aplikacija primila
+//     INPUT_FRAME   f64 vreme frejma (ono sto je dobio update())
+//     INPUT_KEY     i32 key, i32 scancode, u8 action, u8 mods
+//     INPUT_BUTTON  u8 button, u8 action, u8 mods
+//     INPUT_CURSOR  f64 x, f64 y (koordinate prozora)
+//
+// Svi brojevi su little-endian. Sve ostalo sto utice na rezultat (seme, sat, brzina simulacije,
+// vreme init-a, velicina prozora) je u zaglavlju.
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+static const char INPUT_LOG_MAGIC[4] = { 'S', 'W', 'R', 'L' };
+static const std::uint32_t INPUT_LOG_VERSION = 1;
+
+struct InputLogHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t seed;
+    std::int32_t clockEpoch; // sekunda u danu (sistemski sat se snima kao simulirani)
+    double simRate;
+    double startTime;        // vreme pozivaoca u init-u
+    std::int32_t width;      // velicina prozora - osa kursora
+    std::int32_t height;
+};
+
+enum InputEventType : std::uint8_t {
+    INPUT_FRAME = 0,
+    INPUT_KEY = 1,
+    INPUT_BUTTON = 2,
+    INPUT_CURSOR = 3
+};
+
+struct InputEvent {
+    InputEventType type = INPUT_FRAME;
+    double time = 0.0;        // INPUT_FRAME
+    double x = 0.0, y = 0.0;  // INPUT_CURSOR
+    int key = 0, scancode = 0; // INPUT_KEY
+    int button = 0;            // INPUT_BUTTON
+    int action = 0, mods = 0;  // INPUT_KEY, INPUT_BUTTON
+};
+
+// Pise snimak dok aplikacija radi; zapisi idu kroz bafer fajla, bez sistemskog poziva po dogadjaju
+class InputRecorder {
+public:
+    InputRecorder();
+    ~InputRecorder();
+
+    bool open(const char* path, const InputLogHeader& header);
+    void close();
+    bool isOpen() const { return file_ != nullptr; }
+
+    void frame(double time);
+    void key(int key, int scancode, int action, int mods);
+    void mouseButton(int button, int action, int mods);
+    void cursor(double x, double y);
+
+private:
+    void write(const void* data, std::size_t size);
+
+    std::FILE* file_;
+};
+
+// Ceo snimak u memoriji, za reprodukciju bez citanja fajla izmedju frejmova
+class InputReplay {
+public:
+    bool load(const char* path);
+
+    const InputLogHeader& header() const { return header_; }
+    const std::vector<InputEvent>& events() const { return events_; }
+    int frameCount() const { return frames_; }
+
+private:
+    InputLogHeader header_;
+    std::vector<InputEvent> events_;
+    int frames_ = 0;
+};
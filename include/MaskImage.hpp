@@ -0,0 +1,31 @@
+#pragma once
+
+// Jednobojne slike (sve vidljive tacke iste boje, razlikuje se samo alfa) cuvaju se kao maska:
+// jedan kanal pokrivenosti (GL_R8, swizzle (1, 1, 1, R)) plus boja koju crtac mnozi u boju vrha.
+// Deli ga runtime (TextureLoader) i offline alati (atlas_packer, swpak).
+
+#include <cstddef>
+
+// rgba: pixelCount RGBA8 tacaka. Vraca true i boju ako sve tacke sa alfom > 0 imaju istu RGB vrednost
+// (potpuno providna slika nije maska - nema boje).
+inline bool detectMaskColor(const unsigned char* rgba, std::size_t pixelCount, unsigned char outRgb[3]) {
+    bool found = false;
+    for (std::size_t i = 0; i < pixelCount; ++i) {
+        const unsigned char* p = rgba + i * 4;
+        if (p[3] == 0)
+            continue;
+        if (!found) {
+            outRgb[0] = p[0]; outRgb[1] = p[1]; outRgb[2] = p[2];
+            found = true;
+        } else if (p[0] != outRgb[0] || p[1] != outRgb[1] || p[2] != outRgb[2]) {
+            return false;
+        }
+    }
+    return found;
+}
+
+// Alfa kanal kao jednokanalna slika; outAlpha moze biti isti bafer kao rgba (sabija se u mestu)
+inline void extractMaskAlpha(const unsigned char* rgba, std::size_t pixelCount, unsigned char* outAlpha) {
+    for (std::size_t i = 0; i < pixelCount; ++i)
+        outAlpha[i] = rgba[i * 4 + 3];
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <string>
+
+// Kes linkovanih programa na disku (glGetProgramBinary / glProgramBinary). Kljuc je FNV-1a hes
+// izvornog koda oba sejdera i GL_VENDOR / GL_RENDERER / GL_VERSION stringova, pa promena sejdera ili
+// drajvera samo promasi kes. Binarni oblik koji drajver odbije se brise, a program se prevodi iz
+// izvornog koda - za pozivaoca (createShader) je kes nevidljiv.
+class ProgramCache {
+public:
+    // Prazan direktorijum iskljucuje kes; direktorijum se pravi pri prvom upisu
+    void setDirectory(const char* directory) { directory_ = directory ? directory : ""; }
+    bool enabled() const { return !directory_.empty(); }
+
+    // Potreban je tekuci GL kontekst. 0 = kes je iskljucen ili drajver ne podrzava binarne programe.
+    std::uint64_t key(const std::string& vertexSource, const std::string& fragmentSource) const;
+
+    // Program iz kesa (vec linkovan) ili 0
+    GLuint load(std::uint64_t key) const;
+
+    // Poziva se pre glLinkProgram - bez ovog drajver ne mora da zadrzi binarni oblik
+    void prepare(GLuint program, std::uint64_t key) const;
+
+    // Poziva se posle uspesnog linkovanja
+    void store(GLuint program, std::uint64_t key) const;
+
+private:
+    std::string path(std::uint64_t key) const;
+
+    std::string directory_;
+};
+
+// Kes koji koristi createShader; main mu zadaje direktorijum pre init-a
+ProgramCache& programCache();
\ No newline at end of file
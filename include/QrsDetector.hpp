@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Pan-Tompkins detektor QRS kompleksa nad tokom uzoraka, blok po blok:
+//   propusnik opsega 5-15 Hz i izvod (jedan FIR) -> kvadriranje -> integracija pokretnim
+//   prozorom od 150 ms (FIR) -> vrhovi sa adaptivnim pragovima, refraktornim periodom od 200 ms
+//   i pretragom unazad kada otkucaj predugo izostane.
+// Filtri su FIR da bi se racunali SIMD-om preko susednih izlaza (AVX2, SSE2, skalarni); svi
+// kerneli sabiraju istim redom, pa daju isti rezultat. QRS_KERNEL=scalar|sse2|avx2 spusta izbor.
+// Jedan detektor po uredjaju; nije bezbedan za vise niti.
+class QrsDetector {
+public:
+    QrsDetector();
+
+    // sampleRate: 250-1000 Hz (radi i van toga); resetuje stanje
+    void init(double sampleRate);
+
+    // Obradjuje uzorke (mV) redom; vraca broj otkucaja otkrivenih u ovom pozivu
+    int process(const float* samples, int count);
+
+    // Srednja vrednost poslednjih RR intervala; 0 dok nema bar dva otkucaja
+    double bpm() const;
+
+    std::uint64_t beats() const { return beats_; }
+
+    // Vreme poslednjeg R zupca u sekundama od prvog uzorka (kasnjenje filtara je oduzeto)
+    double lastBeatTime() const;
+
+    double sampleRate() const { return sampleRate_; }
+    static const char* kernelName();
+
+private:
+    static const int BLOCK = 256;
+    static const int RR_HISTORY = 8;
+
+    void detect(const float* integrated, int count);
+    void acceptBeat(std::uint64_t index, float peak);
+
+    double sampleRate_;
+    std::vector<float> bandTaps_;  // propusnik opsega * izvod, obrnutim redom
+    std::vector<float> windowTaps_;
+    std::vector<float> input_;     // (bandTaps - 1) prethodnih uzoraka + blok
+    std::vector<float> squared_;   // (windowTaps - 1) prethodnih kvadrata + blok
+    std::vector<float> integrated_;
+    int delay_;                    // kasnjenje filtara u uzorcima
+
+    // Detekcija nad integrisanim signalom
+    std::uint64_t index_;          // indeks sledeceg integrisanog uzorka
+    float prev_[2];                // dva prethodna uzorka, za lokalni maksimum
+    int learning_;                 // uzorci preostali u fazi ucenja (2 s)
+    float learnMax_;
+    double learnSum_;
+    float signalPeak_;             // SPKI
+    float noisePeak_;              // NPKI
+    int refractory_;
+    std::uint64_t lastBeat_;
+    std::uint64_t beats_;
+    float searchPeak_;             // najveci odbaceni vrh od poslednjeg otkucaja (pretraga unazad)
+    std::uint64_t searchIndex_;
+    double rr_[RR_HISTORY];        // u uzorcima
+    int rrCount_;
+};
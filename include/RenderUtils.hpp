@@ -1,6 +1,35 @@
 #pragma once
 
 #include <GL/glew.h>
+#include "ShaderProgram.hpp"
+#include "ShaderVariants.hpp"
+
+// Uniformi varijante basic.vert + quad.frag, razreseni jednom pri prevodjenju varijante;
+// uniformi kojih u varijanti nema ostaju nevazeci i set() ih preskace
+struct QuadShader {
+    ShaderProgram program;
+    UniformVec2 pos;
+    UniformVec2 scale;
+    UniformVec4 uvTransform;
+    UniformVec4 color;
+    UniformFloat fillLevel;
+    UniformSampler image;
+};
+
+QuadShader makeQuadShader(const ShaderProgram& program);
+
+typedef ShaderVariants<QuadShader> QuadShaders;
+
+// Offscreen cilj za iscrtavanje (FBO sa jednom RGBA8 teksturom)
+struct RenderTarget {
+    GLuint fbo = 0;
+    GLuint texture = 0;
+    int width = 0;
+    int height = 0;
+};
+
+bool createRenderTarget(RenderTarget& target, int width, int height);
+void destroyRenderTarget(RenderTarget& target);
 
 unsigned int loadImageToTexture(const char* filepath);
 
@@ -8,10 +37,6 @@ void preprocessTexture(unsigned& texture, const char* filepath);
 
 void formQuadVAO(unsigned int& outVAO, unsigned int& outVBO);
 
-void drawElement(unsigned int shader, unsigned int VAO_local, unsigned int texture,
-                 float x, float y, float w, float h,
-                 float uvX = 0.0f, float uvY = 0.0f, float uvW = 1.0f, float uvH = 1.0f,
-                 float r = 1.0f, float g = 1.0f, float b = 1.0f, float a = 1.0f);
-
-void drawBatteryQuad(unsigned int shader, unsigned int VAO_local,
+// Boja punjenja se bira ovde, jednom po quad-u, a ne u svakom fragmentu
+void drawBatteryQuad(QuadShaders& shaders, unsigned int VAO_local,
                      float x, float y, float w, float h, float level);
\ No newline at end of file
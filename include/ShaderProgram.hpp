@@ -0,0 +1,79 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <string>
+#include <vector>
+
+// Lokacija uniforma razresena jednom, pri linkovanju programa.
+// Postavljanje vrednosti ide direktno na lokaciju, bez glGetUniformLocation.
+struct UniformHandle {
+    GLint location = -1;
+    bool valid() const { return location >= 0; }
+};
+
+struct UniformFloat : UniformHandle {
+    static const GLenum glType = GL_FLOAT;
+    void set(float v) const { if (location >= 0) glUniform1f(location, v); }
+};
+
+struct UniformInt : UniformHandle {
+    static const GLenum glType = GL_INT;
+    void set(int v) const { if (location >= 0) glUniform1i(location, v); }
+};
+
+struct UniformVec2 : UniformHandle {
+    static const GLenum glType = GL_FLOAT_VEC2;
+    void set(float x, float y) const { if (location >= 0) glUniform2f(location, x, y); }
+};
+
+struct UniformVec4 : UniformHandle {
+    static const GLenum glType = GL_FLOAT_VEC4;
+    void set(float x, float y, float z, float w) const { if (location >= 0) glUniform4f(location, x, y, z, w); }
+};
+
+struct UniformSampler : UniformHandle {
+    static const GLenum glType = GL_SAMPLER_2D;
+    void set(int unit) const { if (location >= 0) glUniform1i(location, unit); }
+};
+
+class ShaderProgram {
+public:
+    struct Variable {
+        std::string name;
+        GLint location;
+        GLenum type;
+        GLint size;
+    };
+
+    ShaderProgram();
+
+    // Preuzima vec linkovan program i cita listu aktivnih uniforma i atributa
+    static ShaderProgram fromLinked(GLuint program);
+
+    GLuint id() const { return id_; }
+    bool valid() const { return id_ != 0; }
+    explicit operator bool() const { return valid(); }
+
+    void use() const { glUseProgram(id_); }
+    void destroy();
+
+    // Poziva se pri inicijalizaciji, ne u render petlji
+    template <typename U>
+    U uniform(const char* name) const {
+        U handle;
+        handle.location = findUniform(name, U::glType);
+        return handle;
+    }
+
+    GLint attribute(const char* name) const;
+
+    const std::vector<Variable>& uniforms() const { return uniforms_; }
+    const std::vector<Variable>& attributes() const { return attributes_; }
+
+private:
+    GLint findUniform(const char* name, GLenum expectedType) const;
+
+    GLuint id_;
+    std::vector<Variable> uniforms_;
+    std::vector<Variable> attributes_;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <string>
+
+#include "ShaderProgram.hpp"
+
+// Bitovi osobina varijante; svaki ukljuceni bit postaje #define na pocetku izvornog koda
+// (posle #version), pa jedan .frag daje sve permutacije bez grananja u runtime-u.
+enum ShaderFeature : unsigned {
+    SHADER_TEXTURED   = 1u << 0, // uzorkuje u_image (inace je boja bela)
+    SHADER_ALPHA_TEST = 1u << 1, // discard za alfa < 0.1
+    SHADER_TINT       = 1u << 2, // mnozi bojom u_colorObj
+    SHADER_FILL       = 1u << 3, // odbacuje deo levo od u_fillLevel (punjenje baterije)
+};
+
+static const int SHADER_FEATURE_BITS = 4;
+
+// "#define TEXTURED\n#define TINT\n" ...
+std::string shaderFeatureDefines(unsigned features);
+
+// createShader sa definicijama za date osobine
+ShaderProgram createShaderVariant(const char* vsSource, const char* fsSource, unsigned features);
+
+// Permutacije jednog para sejdera. Varijanta se prevodi tek kada je prvi put zatrazena i ostaje
+// u kesu (a preko ProgramCache i na disku). Shader je tip sa razresenim uniformima (npr. QuadShader)
+// koji pravi make iz linkovanog programa.
+template <typename Shader>
+class ShaderVariants {
+public:
+    typedef Shader (*MakeFn)(const ShaderProgram& program);
+
+    ShaderVariants() : make_(nullptr) {
+        for (int i = 0; i < VARIANT_COUNT; ++i) compiled_[i] = false;
+    }
+
+    void init(const char* vsSource, const char* fsSource, MakeFn make) {
+        vsSource_ = vsSource;
+        fsSource_ = fsSource;
+        make_ = make;
+    }
+
+    // Poziva se iz render petlje - posle prvog poziva za iste osobine to je samo indeksiranje niza.
+    // Ako prevodjenje ne uspe, vraca se Shader sa nevazecim programom (i ne pokusava se ponovo).
+    const Shader& get(unsigned features) {
+        features &= VARIANT_COUNT - 1;
+        if (!compiled_[features]) {
+            programs_[features] = createShaderVariant(vsSource_.c_str(), fsSource_.c_str(), features);
+            shaders_[features] = make_(programs_[features]);
+            compiled_[features] = true;
+        }
+        return shaders_[features];
+    }
+
+    void destroy() {
+        for (int i = 0; i < VARIANT_COUNT; ++i) {
+            if (compiled_[i]) programs_[i].destroy();
+            compiled_[i] = false;
+        }
+    }
+
+private:
+    static const int VARIANT_COUNT = 1 << SHADER_FEATURE_BITS;
+
+    std::string vsSource_;
+    std::string fsSource_;
+    MakeFn make_;
+    ShaderProgram programs_[VARIANT_COUNT];
+    Shader shaders_[VARIANT_COUNT];
+    bool compiled_[VARIANT_COUNT];
+};
+
+// Za sejdere bez posebnih uniforma (npr. SpriteBatch)
+inline ShaderProgram makeProgram(const ShaderProgram& program) { return program; }
\ No newline at end of file
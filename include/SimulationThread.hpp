@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+#include "TripleBuffer.hpp"
+#include "WatchSimulation.hpp"
+
+// Sta simulacija objavljuje posle svakog koraka: poslednja dva stanja, izmedju kojih render interpolira
+struct WatchSnapshot {
+    WatchState previous;
+    WatchState current;
+    double stepTime = 1.0 / WatchSimulation::DEFAULT_RATE;
+
+    // Stanje u trenutku time (osa vremena simulacije); posle poslednjeg koraka se ne ekstrapolira
+    void interpolate(double time, WatchState& outState) const;
+};
+
+// WatchSimulation na sopstvenoj niti: koraca po satu clock() i objavljuje nepromenljive snimke
+// stanja kroz TripleBuffer. Render nit uzima najnoviji snimak bez cekanja, pa spor glfwSwapBuffers
+// ne koci simulaciju, a nalet koraka ne kasni frejm.
+// Bez start() nema niti - korake pokrece advance() na niti pozivaoca (headless, deterministicno).
+class SimulationThread {
+public:
+    SimulationThread();
+    ~SimulationThread(); // zaustavlja nit ako destroy() nije pozvan
+
+    void init(double startTime, double rate = WatchSimulation::DEFAULT_RATE, unsigned seed = 0);
+
+    // clock mora da bude bezbedan za poziv sa druge niti (npr. glfwGetTime)
+    void start(double (*clock)());
+    void destroy();
+
+    bool threaded() const { return thread_.joinable(); }
+
+    // Bilo koja nit; vazi od sledeceg koraka
+    void setRunning(bool running) { running_.store(running, std::memory_order_relaxed); }
+
+    // Pre start(): prsten uzoraka sa senzora; prazni ga nit simulacije
+    void setEcgInput(EcgRing* ring) { sim_.setEcgInput(ring); }
+
+    // Pre start(): prsten svih EKG uzoraka za trag (senzor ili sinteza); puni ga nit simulacije
+    void setEcgOutput(EcgRing* ring) { sim_.setEcgOutput(ring); }
+
+    // Samo bez niti: izvrsava korake do currentTime i objavljuje rezultat
+    void advance(double currentTime);
+
+    // Render nit: najnoviji objavljeni snimak; vazi do sledeceg poziva
+    const WatchSnapshot& latest() {
+        buffer_.update();
+        return buffer_.read();
+    }
+
+private:
+    void threadLoop();
+    void publish();
+
+    WatchSimulation sim_; // posle start() pripada samo niti simulacije
+    TripleBuffer<WatchSnapshot> buffer_;
+    std::thread thread_;
+    std::atomic<bool> running_;
+    std::atomic<bool> stop_;
+    double (*clock_)();
+};
\ No newline at end of file
@@ -2,7 +2,15 @@
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
-#include <random>
+
+#include "SpriteBatch.hpp"
+#include "RenderUtils.hpp"
+#include "TextureAtlas.hpp"
+#include "DigitFont.hpp"
+#include "EkgTrace.hpp"
+#include "TextureLoader.hpp"
+#include "SimulationThread.hpp"
+#include "WallClock.hpp"
 
 enum class AppState {
     Clock,
@@ -13,19 +21,61 @@ enum class AppState {
 class SmartWatchApp {
 public:
     SmartWatchApp();
+    ~SmartWatchApp(); // poziva shutdown()
+
+    // Poziva se pre init: scena se crta u width x height i jednim blit-om razvlaci na izlaz
+    // (sa ocuvanim odnosom stranica); filter je GL_NEAREST ili GL_LINEAR. 0 x 0 = rezolucija izlaza.
+    void setInternalResolution(int width, int height, GLenum filter);
+
+    // Poziva se pre init: koraka simulacije u sekundi (vidi WatchSimulation), nezavisno od frejmova
+    void setSimulationRate(double rate) { simRate_ = rate; }
+
+    // Poziva se pre init: WallClock::SYSTEM ili sekunda u danu koju sat pokazuje pri pokretanju
+    void setClockEpoch(int epoch) { clockEpoch_ = epoch; }
+
+    // Poziva se pre init: seme nasumicnog BPM-a
+    void setSeed(unsigned seed) { seed_ = seed; }
 
+    // Poziva se pre init: vreme pozivaoca u init-u (inace glfwGetTime, odnosno 0 bez prozora);
+    // posle init-a startTime() vraca vreme koje je stvarno uzeto
+    void setStartTime(double time) { startTime_ = time; }
+    double startTime() const { return startTime_; }
+
+    // Poziva se pre init: i u prozoru se sve racuna iz vremena koje daje update() (simulacija
+    // bez niti, sat bez tickera), pa isti ulaz i ista vremena frejmova daju isti rezultat (--record)
+    void setDeterministic(bool deterministic) { deterministic_ = deterministic; }
+
+    // Poziva se pre init: EKG senzor (fajl, FIFO ili "unix:/putanja", vidi EcgReader)
+    void setEcgSource(const char* source) { ecgSource_ = source; }
+    void printEcgStats() const { ecgReader_.printStats(); }
+
+    // window moze biti nullptr (headless). Pozicija kursora stize samo preko onCursorPos.
     bool init(GLFWwindow* window, int screenWidth, int screenHeight);
     void update(double currentTime);
 
-    void render();
+    // Zaustavlja ticker sata, nit simulacije (obe zovu GLFW) i citac EKG-a; mora pre glfwTerminate,
+    // sme vise puta
+    void shutdown();
+
+    // Vraca false ako od proslog frejma nista vidljivo nije promenjeno - tada nema GPU posla
+    // i pozivalac ne treba da menja bafere
+    bool render();
+
+    // Koliko sekundi od currentTime nista vidljivo nece da se promeni bez ulaznog dogadjaja;
+    // 0 ako se nesto animira. Otkucaji sata bude petlju sami (glfwPostEmptyEvent), pa ne skracuju cekanje.
+    double idleTimeout(double currentTime) const;
 
     // input callbacks
     void onKey(int key, int scancode, int action, int mods);
     void onMouseButton(int button, int action, int mods);
+    void onCursorPos(double x, double y);
 
 private:
-    void updateTimeAndBattery(double currentTime);
-    void updateBpmAndEkg(double currentTime, double deltaTime);
+    // Poredi dva uzastopna stanja za iscrtavanje i oznacava sta od vidljivog je promenjeno
+    void markChanges(const WatchState& previous, const WatchState& next);
+
+    // Trenutna sekunda u danu: od tickera ako radi, inace iz vremena
+    int clockSecond(double currentTime) const;
 
     void renderClockScreen();
     void renderHeartScreen();
@@ -33,43 +83,72 @@ private:
     void renderCursorAndOverlay();
     void renderWarningOverlay();
 
+    // Koordinate prozora (kursor) -> NDC interne slike
+    void windowToNdc(double x, double y, float& outX, float& outY) const;
+
+    void drawSprite(SpriteId id, float x, float y, float w, float h,
+                    float r = 1.0f, float g = 1.0f, float b = 1.0f, float a = 1.0f);
+
     GLFWwindow* window_;
     int screenWidth_;
     int screenHeight_;
 
     AppState currentState_;
 
-    // Watch
-    int timeHH_, timeMM_, timeSS_;
-    double lastTimeSecond_;
-
-    // EKG / BPM
-    float bpm_;
-    float ekgOffset_;
-    bool isRunning_;
-    double lastFrameTime_;
-    double lastRandomChange_;
-    std::mt19937 rng_;
-    std::uniform_real_distribution<float> randBpm_;
-    float bpmTargetRandom_;
-
-    // Battery
-    float batteryLevel_;
-    float batteryTimer_;
+    // Sat, baterija, BPM i EKG - fiksni korak na sopstvenoj niti (bez prozora na niti rendera);
+    // view_ je stanje interpolirano iz poslednjeg snimka, ono se crta
+    double simRate_;
+    unsigned seed_;
+    double startTime_;
+    bool deterministic_;
+    // Svi EKG uzorci (senzor ili sinteza): nit simulacije -> prsten -> trag na GPU-u; deklarisan
+    // pre simulation_, pa nadzivi njenu nit
+    EcgRing traceRing_;
+    SimulationThread simulation_;
+    WatchState view_;
+
+    // Uzorci sa senzora: nit citaca -> prsten -> nit simulacije
+    const char* ecgSource_;
+    EcgRing ecgRing_;
+    EcgReader ecgReader_;
+
+    // Vreme na satu; u prozoru granice sekundi javlja timerfd
+    int clockEpoch_;
+    WallClock clock_;
+    TimeOfDay timeOfDay_;
+    int shownSecond_;
 
     // Input
+    bool isRunning_;
     double mouseX_;
     double mouseY_;
-    float squeezeScale_;
 
     // Shaders i geometrija
-    GLuint basicShader_;
-    GLuint batteryShader_;
+    // Permutacije basic.vert + quad.frag i sprite sejdera, prevode se kada zatrebaju
+    QuadShaders quadShaders_;
+    ShaderVariants<ShaderProgram> spriteShaders_;
+    ShaderProgram digitsShader_;
+    ShaderProgram traceShader_;
     GLuint VAO_;
     GLuint VBO_;
-
-    // Teksture
-    GLuint texArrowLeft_, texArrowRight_, texHeart_, texEKG_, texBatteryFrame_;
-    GLuint texNumbers_[10];
-    GLuint texColon_, texPercent_, texIDOverlay_, texWarningFull_;
+    SpriteBatch batch_;
+
+    // Teksture su u atlasu; dekodiraju se paralelno, a init ceka dok sve ne stignu na GPU
+    TextureLoader loader_;
+    TextureAtlas atlas_;
+    DigitFont digits_;
+    EkgTrace trace_;
+
+    // Retained scena
+    unsigned dirty_;
+    bool warningShown_;
+    RenderTarget sceneTarget_;
+
+    // Interna rezolucija: kompozicija ide u frameTarget_, pa na izlaz u pravougaonik present*
+    // (deo izlaza 0..1, centriran)
+    int internalWidth_;
+    int internalHeight_;
+    GLenum upscaleFilter_;
+    RenderTarget frameTarget_;
+    float presentX0_, presentY0_, presentX1_, presentY1_;
 };
\ No newline at end of file
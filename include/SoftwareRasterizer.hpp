@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "AtlasData.hpp"
+#include "ThreadPool.hpp"
+
+// CPU tekstura: RGBA8 (R u najnizem bajtu), redovi odozdo nagore kao u GL teksturi posle flip-a
+struct SoftTexture {
+    int width = 0;
+    int height = 0;
+    bool repeat = false; // GL_REPEAT umesto GL_CLAMP_TO_EDGE
+    std::vector<std::uint32_t> texels;
+};
+
+// mask: jednokanalna slika se ucitava kao bela sa alfom iz slike (TextureFormat::Mask)
+bool loadSoftTexture(SoftTexture& outTexture, const char* filePath, bool repeat = false, bool mask = false);
+
+// CPU zamena za quad pipeline (SpriteBatch / drawBatteryQuad) za ciljeve bez upotrebljivog GL-a.
+// Komande se skupljaju do flush(), a onda se framebuffer deli na plocice koje niti iz pool-a
+// obradjuju nezavisno - svaka plocica izvrsava sve komande redom, pa je redosled crtanja isti kao na GPU.
+// Semantika je ista kao u quad.frag (TEXTURED, ALPHA_TEST, TINT, FILL): bilinearno uzorkovanje, discard za alfa < 0.1,
+// mnozenje bojom i blending GL_SRC_ALPHA / GL_ONE_MINUS_SRC_ALPHA.
+class SoftwareRasterizer {
+public:
+    SoftwareRasterizer();
+
+    // threads: 0 = sva jezgra, 1 = sve na pozivajucoj niti
+    bool init(int width, int height, int threads = 0, int tileSize = 64);
+    void destroy();
+
+    void clear(float r, float g, float b, float a = 1.0f);
+
+    // Isto kao SpriteBatch::draw: (x, y) je centar, (w, h) polu-dimenzije u NDC; texture == nullptr je bela
+    void drawQuad(const SoftTexture* texture, float x, float y, float w, float h,
+                  float uvX = 0.0f, float uvY = 0.0f, float uvW = 1.0f, float uvH = 1.0f,
+                  float r = 1.0f, float g = 1.0f, float b = 1.0f, float a = 1.0f);
+
+    // Sprite iz atlasa, ista matematika odsecanja kao SpriteBatch::draw
+    void drawSprite(const SoftTexture& page, const AtlasRegion& region, float x, float y, float w, float h,
+                    float r = 1.0f, float g = 1.0f, float b = 1.0f, float a = 1.0f);
+
+    // Isto kao drawBatteryQuad
+    void drawBatteryQuad(float x, float y, float w, float h, float level);
+
+    void flush();
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    int threadCount() const { return pool_.threadCount(); }
+    const char* kernelName() const;
+
+    // RGBA8, redovi odozdo nagore (isti raspored kao glReadPixels)
+    const std::uint32_t* pixels() const { return color_.data(); }
+
+private:
+    enum class CommandType { Clear, Textured, Solid };
+
+    struct Command {
+        CommandType type;
+        const SoftTexture* texture;
+        int x0, y0, x1, y1;   // pikseli, kraj je iskljucen
+        float u0, du, v0, dv; // tekstura u centru piksela (x0, y0) i korak po pikselu
+        float color[4];
+    };
+
+    bool pixelRect(float left, float bottom, float right, float top, Command& cmd) const;
+    void renderTile(int tile);
+
+    int width_;
+    int height_;
+    int tileSize_;
+    int tilesX_;
+    int tilesY_;
+
+    std::vector<std::uint32_t> color_;
+    std::vector<Command> commands_;
+    ThreadPool pool_;
+};
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <vector>
+#include <cstddef>
+
+#include "AtlasData.hpp"
+#include "ShaderVariants.hpp"
+
+struct SpriteVertex {
+    float x, y;
+    float u, v;
+    float r, g, b, a;
+};
+
+// Skuplja quad-ove tokom frejma i iscrtava ih u sto manje draw poziva.
+// Quad-ovi se sortiraju po (layer, shader, tekstura); unutar istog sloja redosled
+// crtanja nije garantovan, pa elementi koji se preklapaju moraju biti u razlicitim slojevima.
+class SpriteBatch {
+public:
+    SpriteBatch();
+
+    // Podrazumevani shader je varijanta TEXTURED | ALPHA_TEST; quad-ovi bez teksture idu kroz
+    // varijantu bez uzorkovanja i discard-a (prevodi se kada prvi put zatreba)
+    bool init(ShaderVariants<ShaderProgram>& shaders, std::size_t initialQuads = 64);
+    void destroy();
+
+    void begin();
+
+    // Sticky stanje - vazi za sve naredne draw() pozive do sledece promene
+    void setLayer(int layer) { layer_ = layer; }
+    void setShader(GLuint shader) { shader_ = shader; }
+
+    // (x, y) je centar, (w, h) polu-dimenzije u NDC.
+    // texture == 0 je jednobojni pravougaonik (sa setShader sejderom: bela tekstura)
+    void draw(GLuint texture, float x, float y, float w, float h,
+              float uvX = 0.0f, float uvY = 0.0f, float uvW = 1.0f, float uvH = 1.0f,
+              float r = 1.0f, float g = 1.0f, float b = 1.0f, float a = 1.0f);
+
+    // Sprite iz atlasa; (x, y, w, h) opisuje celu originalnu sliku, odseceni okvir se preskace
+    void draw(GLuint texture, const AtlasRegion& region, float x, float y, float w, float h,
+              float r = 1.0f, float g = 1.0f, float b = 1.0f, float a = 1.0f);
+
+    void flush();
+
+    int lastDrawCalls() const { return lastDrawCalls_; }
+
+private:
+    struct Quad {
+        int layer;
+        GLuint shader;
+        GLuint texture;
+        unsigned order;
+        float x, y, w, h;
+        float uvX, uvY, uvW, uvH;
+        float r, g, b, a;
+    };
+
+    void ensureCapacity(std::size_t quads);
+
+    // Najvise capacity_ sortiranih quad-ova od first
+    void drawRange(std::size_t first, std::size_t count);
+
+    ShaderVariants<ShaderProgram>* shaders_;
+    GLuint defaultShader_;
+    GLuint whiteTexture_;
+    GLuint VAO_;
+    GLuint VBO_;
+    GLuint EBO_;
+    std::size_t capacity_;
+
+    int layer_;
+    GLuint shader_;
+    int lastDrawCalls_;
+
+    std::vector<Quad> quads_;
+    std::vector<SpriteVertex> vertices_;
+};
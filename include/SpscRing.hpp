@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Prsten za jednog pisca i jednog citaoca, bez brava: svaka strana menja samo svoj indeks, a
+// tudji cita atomicno. Indeksi su u posebnim linijama kesa, a svaka strana pamti poslednju
+// vrednost tudjeg indeksa, pa ga cita tek kada joj prostor (odnosno podaci) ponestane.
+// Kada je pun, push odbacuje novi element i broji ga - pisac nikad ne ceka citaoca.
+template <typename T>
+class SpscRing {
+public:
+    // capacity se zaokruzuje na stepen dvojke
+    explicit SpscRing(std::size_t capacity = 4096)
+        : head_(0), tail_(0), dropped_(0), cachedTail_(0), cachedHead_(0)
+    {
+        std::size_t size = 1;
+        while (size < capacity) size <<= 1;
+        buffer_.resize(size);
+        mask_ = size - 1;
+    }
+
+    std::size_t capacity() const { return buffer_.size(); }
+
+    // Pisac: false (i jedan odbacen element vise) ako je prsten pun
+    bool push(const T& value) {
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        if (head - cachedTail_ >= buffer_.size()) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head - cachedTail_ >= buffer_.size()) {
+                dropped_.store(dropped_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+                return false;
+            }
+        }
+        buffer_[head & mask_] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Citalac: prepisuje do maxCount elemenata u out; vraca koliko ih je bilo
+    std::size_t pop(T* out, std::size_t maxCount) {
+        std::uint64_t tail = tail_.load(std::memory_order_relaxed);
+        if (cachedHead_ - tail < maxCount)
+            cachedHead_ = head_.load(std::memory_order_acquire);
+
+        std::size_t count = static_cast<std::size_t>(cachedHead_ - tail);
+        if (count > maxCount) count = maxCount;
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = buffer_[(tail + i) & mask_];
+
+        tail_.store(tail + count, std::memory_order_release);
+        return count;
+    }
+
+    // Bilo koja nit: ukupno upisano i ukupno odbaceno zbog punog prstena
+    std::uint64_t pushed() const { return head_.load(std::memory_order_relaxed); }
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    std::vector<T> buffer_;
+    std::size_t mask_;
+
+    alignas(64) std::atomic<std::uint64_t> head_;    // pise samo pisac
+    alignas(64) std::atomic<std::uint64_t> tail_;    // pise samo citalac
+    alignas(64) std::atomic<std::uint64_t> dropped_; // pise samo pisac
+    std::uint64_t cachedTail_;                        // samo pisac
+    alignas(64) std::uint64_t cachedHead_;            // samo citalac
+};
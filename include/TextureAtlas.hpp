@@ -0,0 +1,21 @@
+#pragma once
+
+#include <GL/glew.h>
+#include "AtlasData.hpp"
+#include "TextureLoader.hpp"
+
+// Strane atlasa generisane alatom tools/atlas_packer; sprite-ovi se adresiraju preko SpriteId
+class TextureAtlas {
+public:
+    TextureAtlas();
+
+    // Strane stizu asinhrono - spremne su kada loader javi resident(page(i))
+    void load(TextureLoader& loader, int priority);
+
+    GLuint page(int index) const { return pages_[index]; }
+    GLuint texture(SpriteId id) const { return pages_[region(id).page]; }
+    const AtlasRegion& region(SpriteId id) const { return kAtlasRegions[static_cast<int>(id)]; }
+
+private:
+    GLuint pages_[kAtlasPageCount];
+};
\ No newline at end of file
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "AssetPack.hpp"
+
+// Format GL_TEXTURE_2D teksture. Maska je GL_R8 sa swizzle-om (1, 1, 1, R): shader dobija belu boju
+// sa alfom iz slike, a pravu boju daje boja vrha (maskColor) - cetiri puta manje memorije i propusnog opsega.
+enum class TextureFormat {
+    RGBA,    // GL_RGBA8
+    Mask,    // slika je vec jednokanalna pokrivenost (npr. maska strana atlasa), boja je na pozivaocu
+    AutoMask // maska ako su sve vidljive tacke iste boje (MaskImage.hpp), inace RGBA
+};
+
+// Ucitavanje tekstura pri pokretanju: PNG-ovi se dekodiraju (i okrecu) paralelno na radnim nitima,
+// a GL nit ih salje na GPU preko pixel buffer objekta. Ime teksture se dobija odmah pri zahtevu,
+// pa vlasnik moze odmah da podesi parametre; sadrzaj stize tek kada ga pump()/waitFor() posalje.
+// Manji prioritet se dekodira i salje ranije - tako prvi ekran ne ceka ostale slike.
+// Slike koje postoje u assetPack() se ne dekodiraju, vec se salju direktno iz mapiranog paketa.
+class TextureLoader {
+public:
+    TextureLoader();
+    ~TextureLoader(); // samo zaustavlja niti; GL objekte brise destroy()
+
+    GLuint requestTexture(const char* filePath, int priority, bool mipmaps = false,
+                          TextureFormat format = TextureFormat::RGBA);
+
+    // GL_TEXTURE_2D_ARRAY, sloj i = filePaths[i]; svi slojevi istih dimenzija.
+    // channels: 4 za RGBA slike, 1 za jednokanalne (npr. SDF) - cuvaju se kao GL_R8
+    GLuint requestTextureArray(const char* const* filePaths, int count, int channels, int priority);
+
+    // threads: 0 = onoliko koliko ima jezgara (ne vise od broja slika)
+    void start(int threads = 0);
+
+    // GL nit: salje na GPU sve sto je do sada dekodirano; vraca broj tekstura koje jos nisu spremne
+    int pump();
+
+    // GL nit: ceka i salje dok sve teksture prioriteta <= maxPriority ne budu spremne.
+    // Vraca false ako neka od njih nije mogla da se ucita.
+    bool waitFor(int maxPriority);
+
+    bool resident(GLuint texture) const;
+
+    // Ako je tekstura ucitana kao maska, upisuje njenu boju (bela za TextureFormat::Mask) i vraca true
+    bool maskColor(GLuint texture, float outRgb[3]) const;
+
+    void destroy();
+
+private:
+    struct Texture {
+        GLuint id;
+        GLenum target;
+        GLenum internalFormat;
+        GLenum format;
+        int channels;
+        int layers;
+        int pendingLayers;
+        int priority;
+        int width;
+        int height;
+        bool mipmaps;
+        bool allocated;
+        bool failed;
+        bool mask;
+        float maskColor[3];
+    };
+
+    struct Job {
+        std::string path;
+        std::size_t texture; // indeks u textures_
+        int layer;
+        int priority;
+        int channels;
+        bool detectMask;          // TextureFormat::AutoMask
+        const SwpakEntry* packed; // != nullptr - salje se direktno iz paketa, bez dekodiranja
+
+        // Popunjava radna nit; jednobojna slika se sabija na alfu (channels = 1, mask = true)
+        bool ok;
+        bool mask;
+        unsigned char maskColor[3];
+        int width;
+        int height;
+        std::vector<unsigned char> pixels;
+    };
+
+    void workerLoop();
+    void upload(Job& job);
+    void uploadPacked(Job& job, Texture& tex);
+    static void setMask(Texture& tex, const unsigned char* rgb);
+    bool texturesReady(int maxPriority, bool& outFailed) const;
+
+    std::vector<Texture> textures_;
+    std::vector<std::unique_ptr<Job>> jobs_;
+    std::vector<Job*> decodeJobs_; // poslovi za radne niti (bez upakovanih)
+    std::vector<std::thread> workers_;
+    std::atomic<std::size_t> nextJob_;
+    std::atomic<bool> stop_;
+
+    std::mutex mutex_;
+    std::condition_variable decoded_;
+    std::vector<Job*> ready_; // dekodirano, ceka upload (pod mutex_)
+
+    GLuint pbo_;
+    int pendingTextures_;
+};
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fiksan skup radnih niti za paralelne petlje. Nit koja poziva parallelFor i sama radi,
+// pa pool sa jednom niti nema dodatnih niti i sve se izvrsava sinhrono.
+class ThreadPool {
+public:
+    ThreadPool();
+    ~ThreadPool(); // zaustavlja niti ako destroy() nije pozvan
+
+    // threads je ukupan broj niti ukljucujuci pozivaoca; 0 znaci onoliko koliko ima jezgara
+    void init(int threads = 0);
+    void destroy();
+
+    int threadCount() const { return static_cast<int>(workers_.size()) + 1; }
+
+    // Poziva fn(i) za svako i iz [0, count) i vraca se tek kada su svi pozivi zavrseni
+    void parallelFor(int count, const std::function<void(int)>& fn);
+
+private:
+    void workerLoop();
+    void runJobs();
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+
+    const std::function<void(int)>* job_;
+    int jobCount_;
+    std::atomic<int> nextJob_;
+    int activeWorkers_;
+    unsigned generation_;
+    bool stop_;
+};
\ No newline at end of file
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Hijerarhijski tajmer tockovi (4 nivoa po 256 slotova, kao u Linux kernelu) za periodicne i
+// jednokratne zadatke. Vreme se meri u otkucajima; advance() je O(1) bez obzira na broj
+// zadataka - radi samo slot koji je na redu, a zadaci sa udaljenim rokom se spustaju u nizi
+// nivo jednom na 256 otkucaja svog nivoa.
+class TimerWheel {
+public:
+    typedef std::function<void()> Callback;
+    typedef int TaskId;
+
+    static const TaskId INVALID_TASK = -1;
+
+    TimerWheel();
+
+    // Brise sve zadatke i vraca vreme na 0
+    void reset();
+
+    // Zadatak se izvrsava posle delay otkucaja (najmanje 1), pa na svakih period (0 - jednom)
+    TaskId schedule(std::uint64_t delay, std::uint64_t period, Callback callback);
+    void cancel(TaskId id);
+
+    // Jedan otkucaj: izvrsava zadatke ciji je rok sada. Zadaci smeju da zakazuju i otkazuju.
+    void advance();
+
+    std::uint64_t now() const { return now_; }
+
+    // Najraniji rok medju zakazanim zadacima (UINT64_MAX ako ih nema). O(broj zadataka) - za
+    // preskakanje praznih otkucaja, ne za svaki otkucaj.
+    std::uint64_t nextDue() const;
+
+    // Pomera vreme na tick bez izvrsavanja; do tick ukljucivo ne sme biti rokova (vidi nextDue).
+    // Zadaci se ponovo rasporedjuju po slotovima, O(broj zadataka).
+    void skipTo(std::uint64_t tick);
+
+    // Otkucaj u kome se zadatak sledeci put izvrsava
+    std::uint64_t dueTick(TaskId id) const { return tasks_[id].due; }
+
+    bool active(TaskId id) const;
+
+private:
+    static const int LEVELS = 4;
+    static const int SLOT_BITS = 8;
+    static const int SLOTS = 1 << SLOT_BITS;
+    static const unsigned SLOT_MASK = SLOTS - 1;
+
+    struct Task {
+        std::uint64_t due = 0;
+        std::uint64_t period = 0;
+        Callback callback;
+        int prev = -1; // dvostruko povezana lista slota - otkazivanje je O(1)
+        int next = -1;
+        int slot = -1; // level * SLOTS + slot u kome je zadatak; -1 ako nije zakazan
+    };
+
+    void link(TaskId id);
+    void unlink(TaskId id);
+    void cascade(int level);
+
+    std::vector<Task> tasks_;
+    std::vector<TaskId> free_;
+    std::vector<TaskId> scratch_; // skipTo
+    int slots_[LEVELS * SLOTS]; // glava liste svakog slota
+    std::uint64_t now_;
+};
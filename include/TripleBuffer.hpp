@@ -0,0 +1,47 @@
+#pragma once
+
+#include <atomic>
+
+// Trostruki bafer za jednog pisca i jednog citaoca, bez brava i bez cekanja: pisac uvek ima
+// svoj bafer, citalac svoj, a treci je "srednji" koji se razmenjuje jednom atomicnom operacijom.
+// Citalac dobija najnovije objavljeno stanje (medjustanja se preskacu); nijedna strana ne ceka drugu.
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() : write_(0), read_(1), middle_(2) {}
+
+    // Pisac: bafer koji se popunjava; posle publish() je to novi bafer
+    T& writeBuffer() { return buffers_[write_].value; }
+
+    // Pisac: objavljuje writeBuffer() i uzima srednji bafer za sledece pisanje
+    void publish() {
+        unsigned previous = middle_.exchange(write_ | FRESH, std::memory_order_acq_rel);
+        write_ = previous & INDEX;
+    }
+
+    // Citalac: preuzima najnoviji objavljeni bafer ako ga ima; vraca true ako se read() promenio
+    bool update() {
+        if (!(middle_.load(std::memory_order_relaxed) & FRESH))
+            return false;
+        unsigned previous = middle_.exchange(read_, std::memory_order_acq_rel);
+        read_ = previous & INDEX;
+        return true;
+    }
+
+    // Citalac: poslednje preuzeto stanje; vazi do sledeceg update()
+    const T& read() const { return buffers_[read_].value; }
+
+private:
+    static const unsigned INDEX = 3;
+    static const unsigned FRESH = 4; // srednji bafer je objavljen, a citalac ga jos nije uzeo
+
+    // Svaki bafer u svojoj liniji kesa, da pisac i citalac ne dele linije
+    struct alignas(64) Slot {
+        T value;
+    };
+
+    Slot buffers_[3];
+    unsigned write_; // samo pisac
+    unsigned read_;  // samo citalac
+    alignas(64) std::atomic<unsigned> middle_;
+};
\ No newline at end of file
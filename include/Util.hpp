@@ -1,6 +1,8 @@
 #pragma once
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
-unsigned int createShader(const char* vsSource, const char* fsSource);
+#include "ShaderProgram.hpp"
+// defines: npr. "#define TEXTURED\n", umece se posle #version u oba sejdera
+ShaderProgram createShader(const char* vsSource, const char* fsSource, const char* defines = nullptr);
 unsigned loadImageToTexture(const char* filePath);
 GLFWcursor* loadImageToCursor(const char* filePath);
\ No newline at end of file
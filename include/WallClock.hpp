@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+
+// Sekunda u danu (0..86399) -> HH:MM:SS
+struct TimeOfDay {
+    int hh = 0, mm = 0, ss = 0;
+
+    static TimeOfDay fromSecond(int secondOfDay);
+};
+
+// "HH:MM:SS" -> sekunda u danu
+bool parseTimeOfDay(const char* text, int& outSecond);
+
+// Vreme na satu, izvedeno iz sata a ne sabiranjem proteklih sekundi, pa ne kasni:
+//  - sistemsko: lokalno vreme iz CLOCK_REALTIME
+//  - simulirano: epoch (sekunda u danu) u trenutku startTime, pa dalje po vremenu pozivaoca
+// Granice sekundi javlja timerfd poravnat na cele sekunde (startTicker) - render se budi tacno
+// kada se prikaz menja, bez proveravanja u svakom frejmu. Bez tickera (headless, ne-Linux)
+// pozivalac sam pita secondOfDay(time).
+class WallClock {
+public:
+    static const int SYSTEM = -1;                   // epoch za sistemsko vreme
+    static const int DEFAULT_EPOCH = 23 * 3600 + 59 * 60 + 55;
+
+    WallClock();
+    ~WallClock(); // zaustavlja ticker
+
+    // epoch je SYSTEM ili sekunda u danu; startTime je vreme pozivaoca u kome sat pokazuje epoch
+    void init(int epoch, double startTime);
+
+    bool system() const { return epoch_ == SYSTEM; }
+
+    // Sekunda u danu u trenutku time (vreme pozivaoca; za sistemski sat se ne koristi)
+    int secondOfDay(double time) const;
+
+    // Koliko je od time ostalo do sledece promene sekunde (0..1]
+    double untilNextSecond(double time) const;
+
+    // Linux: nit koja ceka na timerfd i na svakoj granici sekunde azurira tickedSecond() i zove
+    // onTick (npr. glfwPostEmptyEvent). clock je vreme pozivaoca, mora da bude bezbedan za poziv
+    // sa druge niti i da tece po CLOCK_MONOTONIC (glfwGetTime). Vraca false ako ticker nije podrzan.
+    bool startTicker(double (*clock)(), void (*onTick)());
+    void stopTicker();
+
+    bool ticking() const { return thread_.joinable(); }
+
+    // Sekunda u danu posle poslednjeg otkucaja tickera (bilo koja nit)
+    int tickedSecond() const { return tickedSecond_.load(std::memory_order_acquire); }
+
+private:
+    bool armTimer();
+    void tickerLoop();
+
+    int epoch_;
+    double startTime_;
+
+    std::thread thread_;
+    std::atomic<int> tickedSecond_;
+    int nextSecond_;   // simulirani sat: sekunda koju donosi sledeci otkucaj
+    int timerFd_;
+    int stopFd_;
+    double (*clock_)();
+    void (*onTick_)();
+};
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "EcgSource.hpp"
+#include "EcgSynth.hpp"
+#include "QrsDetector.hpp"
+#include "TimerWheel.hpp"
+
+// Sve sto se menja s vremenom (baterija, BPM, EKG, stezanje sata); bez GL-a i bez ulaza osim
+// "running" (drzi se D). Vreme na satu nije ovde - izvodi ga WallClock.
+struct WatchState {
+    double time = 0.0;            // simulirano vreme u sekundama (ista osa kao vreme koje daje pozivalac)
+    float batteryLevel = 1.0f;
+    double nextBatteryDrop = 0.0; // kada baterija sledeci put pada
+    float bpm = 70.0f;
+    float bpmTarget = 70.0f;
+    float ecgValue = 0.0f;           // poslednji uzorak sa senzora (mV)
+    std::uint64_t ecgSamples = 0;    // ukupno primljenih uzoraka; 0 - senzor nije povezan
+    float ecgBpm = 0.0f;             // BPM iz R-R intervala senzora; 0 - nije izmeren ili je zastareo
+    float squeezeScale = 1.0f;
+    bool running = false;
+
+    bool warning() const { return bpm > 200.0f; }
+};
+
+// Neprekidne vrednosti (vreme, BPM, stezanje) linearno izmedju from i to (alpha 0..1),
+// diskretne (baterija, ...) su iz to
+void interpolateState(const WatchState& from, const WatchState& to, double alpha, WatchState& outState);
+
+// Simulacija sa fiksnim korakom (podrazumevano 250 Hz), nezavisna od brzine iscrtavanja: isti
+// niz koraka daje isto stanje bez obzira na to koliko cesto se zove advance(). Render crta
+// interpolaciju izmedju poslednja dva koraka.
+// Periodicni poslovi (pad baterije, novi cilj BPM-a, ...) su zadaci na TimerWheel-u ciji je
+// otkucaj jedan korak - korak ne proverava rokove, vec se izvrsava samo ono sto je na redu.
+class WatchSimulation {
+public:
+    static constexpr double DEFAULT_RATE = 250.0;
+
+    // Najvise ovoliko sekundi se nadoknadjuje odjednom (npr. posle suspendovanja procesa)
+    static constexpr double MAX_CATCH_UP = 5.0;
+
+    static constexpr double BATTERY_PERIOD = 10.0; // baterija pada 1% na svakih 10 sekundi
+    static constexpr double RETARGET_PERIOD = 0.5; // novi nasumicni cilj BPM-a dok se miruje
+    static constexpr double SYNTH_RATE = 500.0;    // ucestanost sintetisanog EKG-a
+
+    // Izmereni BPM zastareva kada otkucaja nema ECG_BPM_TIMEOUT sekundi, odnosno
+    // ECG_BPM_TIMEOUT_RR R-R intervala ako je to duze (senzor zatvoren, ravna linija)
+    static constexpr double ECG_BPM_TIMEOUT = 2.0;
+    static constexpr double ECG_BPM_TIMEOUT_RR = 3.0;
+
+    typedef std::function<void(WatchState&)> Task;
+
+    WatchSimulation();
+
+    // Zadaci pamte this
+    WatchSimulation(const WatchSimulation&) = delete;
+    WatchSimulation& operator=(const WatchSimulation&) = delete;
+
+    // startTime je vreme pozivaoca koje odgovara pocetnom stanju
+    void init(double startTime, double rate = DEFAULT_RATE, unsigned seed = 0);
+
+    // Ulaz vazi od sledeceg koraka
+    void setRunning(bool running) { running_ = running; }
+
+    // Uzorci sa senzora (vidi EcgReader); svaki korak prazni prsten i pusta uzorke kroz
+    // QrsDetector. Kada detektor izmeri R-R intervale, BPM prati njih umesto nasumicnog cilja.
+    // Citalac prstena je nit koja koraca simulaciju. nullptr - bez senzora.
+    void setEcgInput(EcgRing* ring) { ecgInput_ = ring; }
+
+    // Svi EKG uzorci idu i u ovaj prsten, za iscrtavanje traga: sa senzora, a bez njega
+    // sintetisani (EcgSynth, SYNTH_RATE) po trenutnom BPM-u simulacije. Vremena su na osi
+    // simulacije (uzorcima senzora se dodaje pomeraj) i ne opadaju. Pisac je nit koja koraca
+    // simulaciju. nullptr - bez izlaza (i bez sinteze).
+    void setEcgOutput(EcgRing* ring) { ecgOutput_ = ring; }
+
+    // Zadatak nad stanjem posle delay sekundi, pa na svakih period (0 - jednom); vreme se
+    // zaokruzuje na korake. Zadaci se brisu u init().
+    TimerWheel::TaskId schedule(double delay, double period, Task task);
+    void cancel(TimerWheel::TaskId id) { timers_.cancel(id); }
+
+    // Izvrsava sve korake do currentTime; vraca koliko ih je bilo
+    int advance(double currentTime);
+
+    // Bez iscrtavanja: pomera simulaciju za duration sekundi preskacuci korake izmedju rokova
+    // zadataka - tu su BPM i stezanje zatvorene forme istih jednacina, a sintetisani EKG se
+    // preskace. Koraci sa rokom se izvrsavaju normalno. Vraca broj koraka.
+    std::uint64_t fastForward(double duration);
+
+    const WatchState& current() const { return current_; }
+    const WatchState& previous() const { return previous_; }
+
+    // Udeo koraka izmedju previous() i current() do poslednjeg advance() (0..1)
+    double alpha() const { return accumulator_ / stepTime_; }
+
+    // Vreme pozivaoca u kome advance() izvrsava sledeci korak
+    double nextStepTime() const { return lastTime_ + stepTime_ - accumulator_; }
+
+    // Stanje za iscrtavanje: neprekidne vrednosti se interpoliraju, diskretne su iz current()
+    void interpolate(WatchState& outState) const;
+
+    double rate() const { return rate_; }
+    double stepTime() const { return stepTime_; }
+    std::uint64_t steps() const { return steps_; }
+
+private:
+    void step();
+    void skipSteps(std::uint64_t count);
+    void drainEcg(WatchState& state);
+    void detectQrs(const EcgSample* samples, std::size_t count, WatchState& state);
+    void expireEcgBpm(WatchState& state);
+    void synthesizeEcg(WatchState& state);
+    void forwardEcg(EcgSample* samples, std::size_t count, const WatchState& state);
+    std::uint64_t toSteps(double seconds) const;
+
+    double rate_;
+    double stepTime_;
+    double startTime_;
+    double lastTime_;
+    double accumulator_;
+    std::uint64_t steps_;
+    bool running_;
+
+    WatchState previous_;
+    WatchState current_;
+
+    EcgRing* ecgInput_;
+    EcgRing* ecgOutput_;
+    double ecgTimeOffset_; // vreme senzora -> vreme simulacije
+    bool ecgTimeSynced_;
+    double ecgLastForwarded_; // vreme poslednjeg uzorka poslatog u ecgOutput_
+    EcgSynth synth_;
+
+    // Ucestanost senzora se procenjuje iz vremena prvih RATE_PROBE uzoraka, pa se tek onda
+    // pokrece detektor (i dobija te uzorke)
+    static const int RATE_PROBE = 64;
+    QrsDetector qrs_;
+    bool qrsReady_;
+    double qrsBeatTime_; // vreme simulacije poslednjeg otkrivenog otkucaja
+    std::vector<EcgSample> rateProbe_;
+    std::vector<float> qrsInput_;
+
+    TimerWheel timers_;
+    TimerWheel::TaskId batteryTask_;
+
+    std::mt19937 rng_;
+    std::uniform_real_distribution<float> randBpm_;
+};
\ No newline at end of file
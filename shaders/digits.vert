@@ -0,0 +1,19 @@
+#version 330 core
+
+layout (location = 0) in vec2 aPos;
+layout (location = 1) in vec2 aTexCoord;
+
+// Po instanci (jedna cifra): centar + polu-dimenzije, sloj u nizu tekstura, boja
+layout (location = 2) in vec4 aRect;
+layout (location = 3) in float aLayer;
+layout (location = 4) in vec4 aColor;
+
+out vec3 TexCoord;
+out vec4 Color;
+
+void main()
+{
+    gl_Position = vec4(aPos * aRect.zw + aRect.xy, 0.0, 1.0);
+    TexCoord = vec3(aTexCoord, aLayer);
+    Color = aColor;
+}
\ No newline at end of file
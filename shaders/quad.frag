@@ -0,0 +1,49 @@
+#version 330 core
+
+// Jedan izvor za pojedinacne quad-ove (drawBatteryQuad); varijante se prave definicijama
+// TEXTURED, ALPHA_TEST, TINT i FILL (vidi ShaderVariants.hpp), pa svaki quad placa samo ono sto koristi.
+
+out vec4 FragColor;
+in vec2 TexCoord;
+
+#ifdef TEXTURED
+// Tekstura objekta (EKG linija, strelice, brojevi, kursor srce)
+uniform sampler2D u_image;
+#endif
+
+#ifdef TINT
+// Boja za mešanje
+uniform vec4 u_colorObj;
+#endif
+
+#ifdef FILL
+// Popunjen deo quad-a s desna (nivo baterije, 0..1)
+uniform float u_fillLevel;
+#endif
+
+void main()
+{
+#ifdef FILL
+    // Odbacujemo piksele levo od trenutnog nivoa punjenja
+    if (TexCoord.x < (1.0 - u_fillLevel))
+        discard;
+#endif
+
+#ifdef TEXTURED
+    vec4 color = texture(u_image, TexCoord);
+#else
+    vec4 color = vec4(1.0);
+#endif
+
+#ifdef ALPHA_TEST
+    // Ako je tekstura providna (alpha < 0.1), odbacujemo piksel (koristimo za kursor srce)
+    if (color.a < 0.1)
+        discard;
+#endif
+
+#ifdef TINT
+    color *= u_colorObj;
+#endif
+
+    FragColor = color;
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#version 330 core
+
+out vec4 FragColor;
+in vec3 TexCoord;
+in vec4 Color;
+
+// Signed distance field glifova (cifre, dvotacka, procenat) - jedan sloj po glifu.
+// 0.5 je ivica, vece vrednosti su unutar glifa.
+uniform sampler2DArray u_glyphs;
+
+void main()
+{
+    float dist = texture(u_glyphs, TexCoord).r;
+
+    // Prelaz sirok oko jednog piksela ekrana - ivica ostaje ostra na svakoj velicini sata
+    float width = fwidth(dist) * 0.75;
+    float alpha = smoothstep(0.5 - width, 0.5 + width, dist);
+
+    if(alpha < 0.01)
+        discard;
+
+    // Glifovi su jednobojni, boju daje instanca
+    FragColor = vec4(Color.rgb, Color.a * alpha);
+}
\ No newline at end of file
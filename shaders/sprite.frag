@@ -0,0 +1,27 @@
+#version 330 core
+
+out vec4 FragColor;
+in vec2 TexCoord;
+in vec4 Color;
+
+// Varijante: TEXTURED i ALPHA_TEST za sprite-ove, bez njih za jednobojne pravougaonike (SpriteBatch)
+#ifdef TEXTURED
+uniform sampler2D u_image;
+#endif
+
+void main()
+{
+#ifdef TEXTURED
+    vec4 texColor = texture(u_image, TexCoord);
+#else
+    vec4 texColor = vec4(1.0);
+#endif
+
+#ifdef ALPHA_TEST
+    // Isto kao quad.frag - providni pikseli se odbacuju
+    if(texColor.a < 0.1)
+        discard;
+#endif
+
+    FragColor = texColor * Color;
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#version 330 core
+
+out vec4 FragColor;
+in float Dist;
+in float TraceX;
+
+uniform float u_width;
+uniform vec4 u_color;
+
+void main()
+{
+    // Uzorci koji jos nisu na redu (desno) ili su izasli iz prozora (levo)
+    if (TraceX < 0.0 || TraceX > 1.0)
+        discard;
+
+    // Ivica se utapa preko jednog piksela
+    float alpha = clamp(0.5 * u_width + 0.5 - abs(Dist), 0.0, 1.0);
+    FragColor = vec4(u_color.rgb, u_color.a * alpha);
+}
@@ -0,0 +1,50 @@
+#version 330 core
+
+// Jedna instanca je jedan segment traga: dva susedna uzorka (vreme po modulu u_wrap, mV).
+// Cetiri temena (gl_VertexID) su uglovi pravougaonika oko segmenta, siroki u_width + 1 piksel.
+layout (location = 0) in vec2 aFrom;
+layout (location = 1) in vec2 aTo;
+
+uniform float u_time;     // vreme desne ivice traga, po modulu u_wrap
+uniform float u_wrap;
+uniform float u_window;   // sekundi na celoj sirini
+uniform vec4 u_rect;      // centar + polu-dimenzije (NDC)
+uniform vec2 u_range;     // mV na donjoj i gornjoj ivici
+uniform vec2 u_viewport;  // velicina cilja u pikselima
+uniform float u_width;    // debljina linije u pikselima
+
+out float Dist;      // rastojanje od ose segmenta u pikselima
+out float TraceX;    // polozaj duz traga, 0 leva ivica, 1 desna
+
+vec2 toPixels(vec2 point, out float traceX)
+{
+    // Starost uzorka u odnosu na desnu ivicu; modul cuva preciznost posle dugog rada
+    float age = mod(u_time - point.x + 0.5 * u_wrap, u_wrap) - 0.5 * u_wrap;
+    traceX = 1.0 - age / u_window;
+    float traceY = (point.y - u_range.x) / (u_range.y - u_range.x);
+    vec2 ndc = u_rect.xy + u_rect.zw * (vec2(traceX, traceY) * 2.0 - 1.0);
+    return (ndc * 0.5 + 0.5) * u_viewport;
+}
+
+void main()
+{
+    float x0, x1;
+    vec2 p0 = toPixels(aFrom, x0);
+    vec2 p1 = toPixels(aTo, x1);
+
+    vec2 dir = p1 - p0;
+    float len = length(dir);
+    dir = len > 1e-4 ? dir / len : vec2(1.0, 0.0);
+    vec2 normal = vec2(-dir.y, dir.x);
+
+    // Pola debljine i pola piksela za prelaz; krajevi se produzavaju isto toliko, da se
+    // susedni segmenti preklope u uglovima
+    float halfWidth = 0.5 * u_width + 0.5;
+    float end = float(gl_VertexID >> 1);
+    float side = (gl_VertexID & 1) == 0 ? -1.0 : 1.0;
+
+    vec2 p = mix(p0, p1, end) + dir * (end * 2.0 - 1.0) * halfWidth + normal * side * halfWidth;
+    Dist = side * halfWidth;
+    TraceX = mix(x0, x1, end);
+    gl_Position = vec4(p / u_viewport * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -0,0 +1,144 @@
+#include "AssetPack.hpp"
+
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define SWPAK_MMAP 1
+#endif
+
+AssetPack::AssetPack()
+    : data_(nullptr),
+      size_(0),
+      mapped_(false)
+{
+}
+
+AssetPack& assetPack() {
+    static AssetPack pack;
+    return pack;
+}
+
+bool AssetPack::open(const char* path) {
+    close();
+
+#ifdef SWPAK_MMAP
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(SwpakHeader))) {
+        ::close(fd);
+        return false;
+    }
+
+    void* mem = mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mem == MAP_FAILED)
+        return false;
+
+    data_ = static_cast<const unsigned char*>(mem);
+    size_ = static_cast<std::size_t>(st.st_size);
+    mapped_ = true;
+#else
+    std::FILE* f = std::fopen(path, "rb");
+    if (!f)
+        return false;
+    std::fseek(f, 0, SEEK_END);
+    long fileSize = std::ftell(f);
+    std::fseek(f, 0, SEEK_SET);
+    buffer_.resize(fileSize > 0 ? static_cast<std::size_t>(fileSize) : 0);
+    bool ok = fileSize >= static_cast<long>(sizeof(SwpakHeader)) &&
+              std::fread(buffer_.data(), 1, buffer_.size(), f) == buffer_.size();
+    std::fclose(f);
+    if (!ok) {
+        buffer_.clear();
+        return false;
+    }
+    data_ = buffer_.data();
+    size_ = buffer_.size();
+#endif
+
+    // Zaglavlje i tabela moraju da stanu, a svi nivoi da budu unutar fajla
+    const SwpakHeader* header = reinterpret_cast<const SwpakHeader*>(data_);
+    bool valid = std::memcmp(header->magic, SWPAK_MAGIC, 4) == 0 && header->version == SWPAK_VERSION &&
+                 sizeof(SwpakHeader) + static_cast<std::size_t>(header->entryCount) * sizeof(SwpakEntry) <= size_;
+
+    const SwpakEntry* entries = reinterpret_cast<const SwpakEntry*>(data_ + sizeof(SwpakHeader));
+    for (std::uint32_t i = 0; valid && i < header->entryCount; ++i) {
+        const SwpakEntry& e = entries[i];
+        valid = (e.channels == 1 || e.channels == 4) && e.levels >= 1 && e.levels <= SWPAK_MAX_LEVELS;
+        for (std::uint32_t l = 0; valid && l < e.levels; ++l) {
+            std::uint64_t bytes = static_cast<std::uint64_t>(swpakLevelSize(e.width, l)) *
+                                  swpakLevelSize(e.height, l) * e.channels;
+            // Bez sabiranja - offset + bytes iz ostecenog paketa moze da se prelije
+            valid = e.offset[l] <= size_ && bytes <= size_ - e.offset[l];
+        }
+    }
+
+    if (!valid) {
+        std::cerr << "Neispravan paket: " << path << "\n";
+        close();
+        return false;
+    }
+    return true;
+}
+
+void AssetPack::close() {
+#ifdef SWPAK_MMAP
+    if (mapped_ && data_)
+        munmap(const_cast<unsigned char*>(data_), size_);
+#endif
+    data_ = nullptr;
+    size_ = 0;
+    mapped_ = false;
+    buffer_.clear();
+}
+
+const SwpakEntry* AssetPack::find(const char* name) const {
+    if (!data_)
+        return nullptr;
+
+    const SwpakHeader* header = reinterpret_cast<const SwpakHeader*>(data_);
+    const SwpakEntry* entries = reinterpret_cast<const SwpakEntry*>(data_ + sizeof(SwpakHeader));
+    for (std::uint32_t i = 0; i < header->entryCount; ++i) {
+        if (std::strncmp(entries[i].name, name, SWPAK_MAX_NAME) != 0)
+            continue;
+
+        // Ako izvorni PNG postoji i razlikuje se od upakovanog, paket je zastareo za ovu sliku
+        struct stat st;
+        if (stat(name, &st) == 0 &&
+            (static_cast<std::uint64_t>(st.st_size) != entries[i].sourceSize ||
+             static_cast<std::int64_t>(st.st_mtime) != entries[i].sourceMtime)) {
+            std::cout << "Paket je zastareo za " << name << ", ucitava se PNG\n";
+            return nullptr;
+        }
+        return &entries[i];
+    }
+    return nullptr;
+}
+
+void AssetPack::uploadTexture2D(const SwpakEntry& entry) const {
+    GLenum format = (entry.channels == 1) ? GL_RED : GL_RGBA;
+    GLint internalFormat = (entry.channels == 1) ? GL_R8 : GL_RGBA8;
+
+    //Redovi su gusto spakovani, bez poravnanja na 4 bajta
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    for (std::uint32_t l = 0; l < entry.levels; ++l) {
+        glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(l), internalFormat,
+                     static_cast<GLsizei>(swpakLevelSize(entry.width, l)),
+                     static_cast<GLsizei>(swpakLevelSize(entry.height, l)), 0,
+                     format, GL_UNSIGNED_BYTE, levelData(entry, l));
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // Tekstura je kompletna i sa delimicnim lancem
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(entry.levels - 1));
+}
\ No newline at end of file
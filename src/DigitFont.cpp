@@ -0,0 +1,159 @@
+#include "DigitFont.hpp"
+#include <cstddef>
+#include <string>
+
+DigitFont::DigitFont()
+    : texture_(0),
+      VAO_(0),
+      quadVBO_(0),
+      instanceVBO_(0),
+      instanceCapacity_(0),
+      lastDrawCalls_(0)
+{
+}
+
+bool DigitFont::init(const ShaderProgram& shader, TextureLoader& loader, int priority) {
+    shader_ = shader;
+
+    // Redosled slojeva odgovara vrednostima cifara i enum-u Glyph
+    const int layerCount = 12;
+    std::string paths[layerCount];
+    const char* pathPtrs[layerCount];
+    for (int i = 0; i < 10; ++i) {
+        paths[i] = "res/sdf/" + std::to_string(i) + ".png";
+    }
+    paths[static_cast<int>(Glyph::Colon)]   = "res/sdf/colon.png";
+    paths[static_cast<int>(Glyph::Percent)] = "res/sdf/percent.png";
+    for (int i = 0; i < layerCount; ++i) pathPtrs[i] = paths[i].c_str();
+
+    texture_ = loader.requestTextureArray(pathPtrs, layerCount, 1, priority);
+    if (texture_ == 0)
+        return false;
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture_);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    UniformSampler glyphs = shader_.uniform<UniformSampler>("u_glyphs");
+    shader_.use();
+    glyphs.set(0);
+
+    float vertices[] = {
+        // pos         // uv
+        -1.0f, -1.0f,  0.0f, 0.0f,
+         1.0f, -1.0f,  1.0f, 0.0f,
+         1.0f,  1.0f,  1.0f, 1.0f,
+        -1.0f,  1.0f,  0.0f, 1.0f
+    };
+
+    glGenVertexArrays(1, &VAO_);
+    glGenBuffers(1, &quadVBO_);
+    glGenBuffers(1, &instanceVBO_);
+
+    glBindVertexArray(VAO_);
+    glBindBuffer(GL_ARRAY_BUFFER, quadVBO_);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
+
+    // position (layout = 0)
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // texture coord (layout = 1)
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO_);
+
+    // rect, layer, color (layout = 2, 3, 4) - jednom po instanci
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, x));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, layer));
+    glEnableVertexAttribArray(3);
+    glVertexAttribDivisor(3, 1);
+
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, r));
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+
+    glBindVertexArray(0);
+
+    instances_.reserve(32);
+    return true;
+}
+
+void DigitFont::destroy() {
+    if (instanceVBO_) glDeleteBuffers(1, &instanceVBO_);
+    if (quadVBO_) glDeleteBuffers(1, &quadVBO_);
+    if (VAO_) glDeleteVertexArrays(1, &VAO_);
+    if (texture_) glDeleteTextures(1, &texture_);
+    instanceVBO_ = quadVBO_ = VAO_ = texture_ = 0;
+    instanceCapacity_ = 0;
+}
+
+void DigitFont::drawNumber(int value, float x, float y, float digitW, float spacing,
+                           float digitH, int minDigits,
+                           float r, float g, float b, float a)
+{
+    if (value < 0) value = 0;
+
+    int digits[10];
+    int count = 0;
+    do {
+        digits[count++] = value % 10;
+        value /= 10;
+    } while (value > 0 && count < 10);
+    while (count < minDigits && count < 10) digits[count++] = 0;
+
+    for (int i = 0; i < count; ++i) {
+        addInstance(digits[count - 1 - i], x + spacing * i, y, digitW, digitH, r, g, b, a);
+    }
+}
+
+void DigitFont::drawGlyph(Glyph glyph, float x, float y, float w, float h,
+                          float r, float g, float b, float a)
+{
+    addInstance(static_cast<int>(glyph), x, y, w, h, r, g, b, a);
+}
+
+void DigitFont::addInstance(int layer, float x, float y, float w, float h,
+                            float r, float g, float b, float a)
+{
+    Instance inst;
+    inst.x = x;
+    inst.y = y;
+    inst.w = w;
+    inst.h = h;
+    inst.layer = static_cast<float>(layer);
+    inst.r = r; inst.g = g; inst.b = b; inst.a = a;
+    instances_.push_back(inst);
+}
+
+void DigitFont::flush() {
+    lastDrawCalls_ = 0;
+    if (instances_.empty())
+        return;
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO_);
+    if (instances_.size() > instanceCapacity_) {
+        instanceCapacity_ = instances_.size() * 2;
+    }
+    // Orphaning, kao u SpriteBatch-u
+    glBufferData(GL_ARRAY_BUFFER, instanceCapacity_ * sizeof(Instance), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, instances_.size() * sizeof(Instance), instances_.data());
+
+    shader_.use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture_);
+
+    glBindVertexArray(VAO_);
+    glDrawArraysInstanced(GL_TRIANGLE_FAN, 0, 4, static_cast<GLsizei>(instances_.size()));
+    glBindVertexArray(0);
+
+    ++lastDrawCalls_;
+    instances_.clear();
+}
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include "EcgSource.hpp"
+
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#define ECG_POSIX 1
+#endif
+
+static double wallSeconds() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+EcgReader::EcgReader()
+    : ring_(nullptr),
+      fd_(-1),
+      paced_(false),
+      firstSampleTime_(0.0),
+      startWall_(0.0),
+      finished_(false),
+      samples_(0),
+      malformed_(0)
+{
+    stopPipe_[0] = stopPipe_[1] = -1;
+}
+
+EcgReader::~EcgReader() {
+    stop();
+}
+
+void EcgReader::printStats() const {
+    if (!ring_)
+        return;
+    std::printf("EKG: %llu uzoraka, %llu odbaceno (pun prsten), %llu neispravnih redova%s\n",
+                static_cast<unsigned long long>(samplesRead()),
+                static_cast<unsigned long long>(ring_->dropped()),
+                static_cast<unsigned long long>(malformed()),
+                finished() ? ", izvor zatvoren" : "");
+}
+
+bool EcgReader::parseLine(const char* line, EcgSample& outSample) {
+    while (*line == ' ' || *line == '\t') ++line;
+    if (*line == '\0' || *line == '#' || *line == '\r')
+        return false;
+
+    char* end = nullptr;
+    double time = std::strtod(line, &end);
+    if (end == line || (*end != ' ' && *end != '\t' && *end != ',')) {
+        malformed_.store(malformed_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return false;
+    }
+    while (*end == ' ' || *end == '\t' || *end == ',') ++end;
+
+    const char* valueText = end;
+    float value = std::strtof(valueText, &end);
+    if (end == valueText) {
+        malformed_.store(malformed_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    outSample.time = time;
+    outSample.value = value;
+    return true;
+}
+
+#ifdef ECG_POSIX
+
+bool EcgReader::start(const char* source, EcgRing& ring) {
+    stop();
+
+    const char* socketPrefix = "unix:";
+    if (std::strncmp(source, socketPrefix, 5) == 0) {
+        sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, source + 5, sizeof(addr.sun_path) - 1);
+
+        fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd_ >= 0 && connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+        paced_ = false;
+    } else {
+        // FIFO se otvara i za pisanje: open ne ceka pisca, a pisac moze da se odvoji i ponovo
+        // poveze bez kraja fajla
+        struct stat st;
+        bool fifo = stat(source, &st) == 0 && S_ISFIFO(st.st_mode);
+        fd_ = open(source, fifo ? O_RDWR : O_RDONLY);
+        paced_ = !fifo;
+    }
+
+    if (fd_ < 0) {
+        std::cerr << "Ne moze da se otvori EKG izvor: " << source << "\n";
+        return false;
+    }
+    if (pipe(stopPipe_) != 0) {
+        close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    ring_ = &ring;
+    finished_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread(&EcgReader::readerLoop, this);
+    return true;
+}
+
+void EcgReader::stop() {
+    if (running()) {
+        char byte = 1;
+        ssize_t written = write(stopPipe_[1], &byte, 1);
+        (void)written;
+        thread_.join();
+    }
+    for (int* fd : { &fd_, &stopPipe_[0], &stopPipe_[1] }) {
+        if (*fd >= 0) close(*fd);
+        *fd = -1;
+    }
+}
+
+bool EcgReader::waitUntil(double sampleTime) {
+    double wait = startWall_ + (sampleTime - firstSampleTime_) - wallSeconds();
+    if (wait <= 0.0)
+        return true;
+
+    // Spava na cevi za zaustavljanje; uzorci ciji je rok prosao do budjenja idu u jednom naletu
+    pollfd stopFd = { stopPipe_[0], POLLIN, 0 };
+    int timeoutMs = static_cast<int>(wait * 1000.0) + 1;
+    return poll(&stopFd, 1, timeoutMs) == 0;
+}
+
+void EcgReader::readerLoop() {
+    pollfd fds[2] = { { fd_, POLLIN, 0 }, { stopPipe_[0], POLLIN, 0 } };
+    char buffer[8192];
+    std::size_t used = 0;
+    bool first = true;
+
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (fds[1].revents)
+            break;
+
+        ssize_t n = read(fd_, buffer + used, sizeof(buffer) - 1 - used);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        // Kraj fajla ili zatvoren socket; poslednji red bez '\n' se obradjuje kao da ga ima
+        bool eof = n == 0;
+        if (eof) {
+            if (used == 0)
+                break;
+            buffer[used++] = '\n';
+        } else {
+            used += static_cast<std::size_t>(n);
+        }
+
+        // Obradjuju se samo celi redovi; ostatak ceka sledece citanje
+        std::size_t lineStart = 0;
+        bool stopped = false;
+        for (std::size_t i = 0; i < used && !stopped; ++i) {
+            if (buffer[i] != '\n')
+                continue;
+            buffer[i] = '\0';
+
+            EcgSample sample;
+            if (parseLine(buffer + lineStart, sample)) {
+                if (paced_) {
+                    if (first) {
+                        firstSampleTime_ = sample.time;
+                        startWall_ = wallSeconds();
+                    }
+                    stopped = !waitUntil(sample.time);
+                }
+                first = false;
+                ring_->push(sample);
+                samples_.store(samples_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+            lineStart = i + 1;
+        }
+        if (stopped || eof)
+            break;
+
+        // Red duzi od bafera se odbacuje
+        if (lineStart == 0 && used == sizeof(buffer) - 1) {
+            malformed_.store(malformed_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            used = 0;
+        } else {
+            std::memmove(buffer, buffer + lineStart, used - lineStart);
+            used -= lineStart;
+        }
+    }
+
+    finished_.store(true, std::memory_order_release);
+}
+
+#else
+
+bool EcgReader::start(const char*, EcgRing&) {
+    return false;
+}
+
+void EcgReader::stop() {
+}
+
+bool EcgReader::waitUntil(double) {
+    return false;
+}
+
+void EcgReader::readerLoop() {
+}
+
+#endif
@@ -0,0 +1,118 @@
+#include "EcgSynth.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+// Talas u odnosu na R zubac: pomeraj (pri RR = 1 s) i sirina u sekundama, amplituda u mV
+struct Wave {
+    double offset;
+    double width;
+    double amplitude;
+    bool scaled; // pomeraj raste sa sqrt(RR)
+};
+
+const Wave WAVES[] = {
+    { -0.20,  0.025,  0.15, true  }, // P
+    { -0.03,  0.010, -0.12, false }, // Q
+    {  0.00,  0.010,  1.20, false }, // R
+    {  0.03,  0.012, -0.25, false }, // S
+    {  0.30,  0.060,  0.30, true  }, // T
+};
+
+} // namespace
+
+EcgSynth::EcgSynth()
+    : startTime_(0.0),
+      index_(0),
+      beats_(0),
+      rrSum_(0.0),
+      rrCount_(0)
+{
+    init(EcgSynthParams());
+}
+
+void EcgSynth::init(const EcgSynthParams& params, double startTime) {
+    params_ = params;
+    if (params_.sampleRate <= 0.0) params_.sampleRate = EcgSynthParams().sampleRate;
+    startTime_ = startTime;
+    index_ = 0;
+    beats_ = 0;
+    rrSum_ = 0.0;
+    rrCount_ = 0;
+    rng_.seed(params_.seed);
+    gauss_.reset();
+    resetBeats(startTime);
+}
+
+void EcgSynth::resetBeats(double time) {
+    // Zamisljeni otkucaj pola intervala pre time, pa sledeca dva od njega
+    double rr = 60.0 / std::max(params_.bpm, 1.0);
+    for (Beat& beat : rPeaks_) {
+        beat.time = time - 0.5 * rr;
+        beat.scale = std::sqrt(rr);
+    }
+    for (int i = 0; i < BEATS - 1; ++i)
+        scheduleBeat();
+}
+
+void EcgSynth::scheduleBeat() {
+    double last = rPeaks_[BEATS - 1].time;
+    double rr = 60.0 / std::max(params_.bpm, 1.0);
+    rr *= 1.0 + params_.rsa * std::sin(2.0 * PI * params_.respiration * last);
+    rr += params_.hrv * gauss_(rng_);
+    rr = std::min(std::max(rr, 0.25), 3.0);
+
+    for (int i = 0; i < BEATS - 1; ++i)
+        rPeaks_[i] = rPeaks_[i + 1];
+    rPeaks_[BEATS - 1].time = last + rr;
+    rPeaks_[BEATS - 1].scale = std::sqrt(rr);
+    rrSum_ += rr;
+    ++rrCount_;
+}
+
+float EcgSynth::sample(double time) {
+    // rPeaks_[0] je poslednji prosli R zubac, rPeaks_[1] sledeci
+    while (time >= rPeaks_[1].time) {
+        scheduleBeat();
+        ++beats_;
+    }
+
+    double value = 0.0;
+    for (const Beat& beat : rPeaks_) {
+        double t = time - beat.time;
+        for (const Wave& wave : WAVES) {
+            double d = (t - wave.offset * (wave.scaled ? beat.scale : 1.0)) / wave.width;
+            if (d > -5.0 && d < 5.0)
+                value += wave.amplitude * std::exp(-0.5 * d * d);
+        }
+    }
+
+    value += params_.wander * std::sin(2.0 * PI * params_.respiration * time);
+    value += params_.noise * gauss_(rng_);
+    return static_cast<float>(value);
+}
+
+void EcgSynth::generate(float* outValues, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i, ++index_)
+        outValues[i] = sample(time());
+}
+
+void EcgSynth::generate(EcgSample* outSamples, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i, ++index_) {
+        outSamples[i].time = time();
+        outSamples[i].value = sample(outSamples[i].time);
+    }
+}
+
+void EcgSynth::skipTo(double time) {
+    double samples = std::ceil((time - startTime_) * params_.sampleRate);
+    std::uint64_t target = samples > 0.0 ? static_cast<std::uint64_t>(samples) : 0;
+    if (target <= index_)
+        return;
+    index_ = target;
+    resetBeats(this->time());
+}
@@ -0,0 +1,191 @@
+#include "EkgTrace.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Vremena u baferu su po modulu ovoga: float tada drzi ~0.1 ms i posle vise sati rada
+static const double TIME_WRAP = 1024.0;
+
+static const float LINE_WIDTH = 2.0f; // pikseli
+
+EkgTrace::EkgTrace()
+    : VAO_(0),
+      VBO_(0),
+      mapped_(nullptr),
+      written_(0)
+{
+}
+
+bool EkgTrace::init(const ShaderProgram& shader) {
+    shader_ = shader;
+    if (!shader_)
+        return false;
+
+    uTime_ = shader_.uniform<UniformFloat>("u_time");
+    uWrap_ = shader_.uniform<UniformFloat>("u_wrap");
+    uWindow_ = shader_.uniform<UniformFloat>("u_window");
+    uRect_ = shader_.uniform<UniformVec4>("u_rect");
+    uRange_ = shader_.uniform<UniformVec2>("u_range");
+    uViewport_ = shader_.uniform<UniformVec2>("u_viewport");
+    uWidth_ = shader_.uniform<UniformFloat>("u_width");
+    uColor_ = shader_.uniform<UniformVec4>("u_color");
+
+    glGenVertexArrays(1, &VAO_);
+    glGenBuffers(1, &VBO_);
+    glBindVertexArray(VAO_);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO_);
+
+    // Jedno mesto vise za ponovljeno prvo
+    GLsizeiptr size = (CAPACITY + 1) * sizeof(Vertex);
+    if (GLEW_VERSION_4_4 || GLEW_ARB_buffer_storage) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+        mapped_ = static_cast<Vertex*>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+        // Nepromenljiv bafer bez mapiranja i dalje moze da se mapira po upisu
+    } else {
+        glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+    }
+
+    // from, to (layout = 0, 1) - jednom po instanci (segmentu); pocetak se zadaje pri crtanju
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribDivisor(0, 1);
+
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)sizeof(Vertex));
+    glEnableVertexAttribArray(1);
+    glVertexAttribDivisor(1, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    times_.assign(CAPACITY, 0.0);
+    written_ = 0;
+    return true;
+}
+
+void EkgTrace::destroy() {
+    if (mapped_) {
+        glBindBuffer(GL_ARRAY_BUFFER, VBO_);
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        mapped_ = nullptr;
+    }
+    if (VBO_) glDeleteBuffers(1, &VBO_);
+    if (VAO_) glDeleteVertexArrays(1, &VAO_);
+    VBO_ = VAO_ = 0;
+    written_ = 0;
+}
+
+void EkgTrace::write(std::size_t slot, const Vertex* vertices, std::size_t count) {
+    if (mapped_) {
+        std::memcpy(mapped_ + slot, vertices, count * sizeof(Vertex));
+        if (slot == 0)
+            mapped_[CAPACITY] = vertices[0];
+        return;
+    }
+
+    // Bez sinhronizacije: GPU cita samo vidljivi deo, a on je daleko od mesta koja se pisu
+    glBindBuffer(GL_ARRAY_BUFFER, VBO_);
+    auto upload = [](std::size_t at, const Vertex* data, std::size_t n) {
+        void* dst = glMapBufferRange(GL_ARRAY_BUFFER, at * sizeof(Vertex), n * sizeof(Vertex),
+                                     GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+        if (dst) {
+            std::memcpy(dst, data, n * sizeof(Vertex));
+            glUnmapBuffer(GL_ARRAY_BUFFER);
+        }
+    };
+    upload(slot, vertices, count);
+    if (slot == 0)
+        upload(CAPACITY, vertices, 1);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void EkgTrace::append(const EcgSample* samples, std::size_t count) {
+    if (!VBO_)
+        return;
+
+    // Iz naleta veceg od prstena ostaje samo kraj
+    if (count > static_cast<std::size_t>(CAPACITY)) {
+        written_ += count - CAPACITY;
+        samples += count - CAPACITY;
+        count = CAPACITY;
+    }
+
+    Vertex block[256];
+    while (count > 0) {
+        std::size_t slot = static_cast<std::size_t>(written_ % CAPACITY);
+        std::size_t n = std::min<std::size_t>({ count, CAPACITY - slot, 256 });
+        for (std::size_t i = 0; i < n; ++i) {
+            block[i].time = static_cast<float>(std::fmod(samples[i].time, TIME_WRAP));
+            block[i].value = samples[i].value;
+            times_[slot + i] = samples[i].time;
+        }
+        write(slot, block, n);
+
+        written_ += n;
+        samples += n;
+        count -= n;
+    }
+}
+
+std::uint64_t EkgTrace::firstAfter(double time) const {
+    std::uint64_t lo = written_ > static_cast<std::uint64_t>(CAPACITY) ? written_ - CAPACITY : 0;
+    std::uint64_t hi = written_;
+    while (lo < hi) {
+        std::uint64_t mid = lo + (hi - lo) / 2;
+        if (times_[mid % CAPACITY] < time)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+bool EkgTrace::visible(double time, double window) const {
+    return written_ > 0 && times_[(written_ - 1) % CAPACITY] >= time - window;
+}
+
+void EkgTrace::draw(double time, double window, float x, float y, float w, float h,
+                    float minValue, float maxValue, int viewportW, int viewportH,
+                    float r, float g, float b, float a)
+{
+    if (written_ < 2)
+        return;
+
+    // Segment koji prelazi levu ivicu je deo traga; desno od time odsece fragment shader
+    std::uint64_t first = firstAfter(time - window);
+    std::uint64_t oldest = written_ > static_cast<std::uint64_t>(CAPACITY) ? written_ - CAPACITY : 0;
+    if (first > oldest)
+        --first;
+    std::uint64_t segments = written_ - 1 - std::min(first, written_ - 1);
+    if (segments == 0)
+        return;
+
+    shader_.use();
+    uTime_.set(static_cast<float>(std::fmod(time, TIME_WRAP)));
+    uWrap_.set(static_cast<float>(TIME_WRAP));
+    uWindow_.set(static_cast<float>(window));
+    uRect_.set(x, y, w, h);
+    uRange_.set(minValue, maxValue);
+    uViewport_.set(static_cast<float>(viewportW), static_cast<float>(viewportH));
+    uWidth_.set(LINE_WIDTH);
+    uColor_.set(r, g, b, a);
+
+    glBindVertexArray(VAO_);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO_);
+
+    // Segment cita mesta slot i slot + 1; drugi poziv samo kada opseg prelazi kraj prstena
+    while (segments > 0) {
+        std::size_t slot = static_cast<std::size_t>(first % CAPACITY);
+        std::size_t n = static_cast<std::size_t>(std::min<std::uint64_t>(segments, CAPACITY - slot));
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(slot * sizeof(Vertex)));
+        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)((slot + 1) * sizeof(Vertex)));
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(n));
+        first += n;
+        segments -= n;
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
@@ -0,0 +1,158 @@
+#include "FrameScheduler.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+
+#ifdef __linux__
+#include <cerrno>
+#include <time.h>
+#endif
+
+bool parseFramePolicy(const char* name, FramePolicy& outPolicy) {
+    if (std::strcmp(name, "ondemand") == 0)      outPolicy = FramePolicy::OnDemand;
+    else if (std::strcmp(name, "vsync") == 0)    outPolicy = FramePolicy::VSync;
+    else if (std::strcmp(name, "deadline") == 0) outPolicy = FramePolicy::Deadline;
+    else return false;
+    return true;
+}
+
+const char* framePolicyName(FramePolicy policy) {
+    switch (policy) {
+        case FramePolicy::OnDemand: return "ondemand";
+        case FramePolicy::VSync:    return "vsync";
+        case FramePolicy::Deadline: return "deadline";
+    }
+    return "?";
+}
+
+double FrameStats::jitter() const {
+    return presented > 2 ? std::sqrt(m2 / static_cast<double>(presented - 2)) : 0.0;
+}
+
+FrameScheduler::FrameScheduler()
+    : policy_(FramePolicy::Deadline),
+      frameTime_(1.0 / 60.0),
+      deadline_(0.0),
+      scheduledWake_(-1.0),
+      lastPresent_(-1.0),
+      lastPresented_(false)
+{
+}
+
+void FrameScheduler::init(FramePolicy policy, double frameTime) {
+    policy_ = policy;
+    frameTime_ = frameTime;
+    stats_ = FrameStats();
+
+    // Samo VSync politika blokira u swap-u; ostale same odredjuju tempo
+    glfwSwapInterval(policy == FramePolicy::VSync ? 1 : 0);
+
+    deadline_ = glfwGetTime();
+    lastPresent_ = -1.0;
+    lastPresented_ = false;
+}
+
+void FrameScheduler::sleepUntil(double deadline) {
+    double remaining = deadline - glfwGetTime();
+    if (remaining <= 0.0)
+        return;
+
+#ifdef __linux__
+    // Apsolutni rok na CLOCK_MONOTONIC - prekid signalom ili kasno budjenje ne pomeraju sledeci rok
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    long long target = static_cast<long long>(ts.tv_sec) * 1000000000LL + ts.tv_nsec
+                     + static_cast<long long>(remaining * 1e9);
+    ts.tv_sec = static_cast<time_t>(target / 1000000000LL);
+    ts.tv_nsec = static_cast<long>(target % 1000000000LL);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+#else
+    std::this_thread::sleep_until(std::chrono::steady_clock::now() +
+                                  std::chrono::duration<double>(remaining));
+#endif
+}
+
+void FrameScheduler::waitForFrame(double idleTimeout) {
+    double timeout = std::max(idleTimeout, frameTime_);
+    double now = glfwGetTime();
+
+    switch (policy_) {
+        case FramePolicy::OnDemand:
+            scheduledWake_ = now + timeout;
+            glfwWaitEventsTimeout(timeout);
+            break;
+
+        case FramePolicy::VSync:
+            // Posle swap-a smo vec sinhronizovani sa ekranom; ako nista nije iscrtano, swap nije
+            // blokirao pa se ceka kao kod OnDemand da se ne bi vrtelo u mestu
+            if (lastPresented_) {
+                scheduledWake_ = -1.0;
+                glfwPollEvents();
+            } else {
+                scheduledWake_ = now + timeout;
+                glfwWaitEventsTimeout(timeout);
+            }
+            break;
+
+        case FramePolicy::Deadline: {
+            double next = deadline_ + frameTime_;
+            if (next < now - frameTime_)
+                next = now; // kasnimo vise od frejma - resinhronizacija
+
+            if (idleTimeout > frameTime_) {
+                // Nista se ne animira: ceka se dogadjaj ili prva granica frejma posle idleTimeout
+                next += std::max(0.0, std::ceil((now + idleTimeout - next) / frameTime_)) * frameTime_;
+                scheduledWake_ = next;
+                glfwWaitEventsTimeout(next - now);
+                deadline_ = std::min(next, glfwGetTime());
+            } else {
+                scheduledWake_ = next;
+                sleepUntil(next);
+                glfwPollEvents();
+                deadline_ = next;
+            }
+            break;
+        }
+    }
+
+    ++stats_.wakeups;
+
+    // Kasnjenje se meri samo za tempirana budjenja; dogadjaji bude ranije i to nije kasnjenje
+    double woke = glfwGetTime();
+    if (scheduledWake_ >= 0.0 && woke > scheduledWake_)
+        stats_.maxLateness = std::max(stats_.maxLateness, woke - scheduledWake_);
+}
+
+void FrameScheduler::frameDone(bool presented) {
+    lastPresented_ = presented;
+    if (!presented)
+        return;
+
+    double now = glfwGetTime();
+    ++stats_.presented;
+    if (lastPresent_ >= 0.0) {
+        double interval = now - lastPresent_;
+        unsigned long n = stats_.presented - 1;
+
+        double delta = interval - stats_.meanInterval;
+        stats_.meanInterval += delta / static_cast<double>(n);
+        stats_.m2 += delta * (interval - stats_.meanInterval);
+
+        if (n == 1 || interval < stats_.minInterval) stats_.minInterval = interval;
+        if (interval > stats_.maxInterval)           stats_.maxInterval = interval;
+    }
+    lastPresent_ = now;
+}
+
+void FrameScheduler::printStats() const {
+    std::printf("Frame policy %s: %lu budjenja, %lu frejmova, razmak %.3f ms (min %.3f, max %.3f), "
+                "jitter %.3f ms, max kasnjenje %.3f ms\n",
+                framePolicyName(policy_), stats_.wakeups, stats_.presented,
+                stats_.meanInterval * 1000.0, stats_.minInterval * 1000.0, stats_.maxInterval * 1000.0,
+                stats_.jitter() * 1000.0, stats_.maxLateness * 1000.0);
+}
\ No newline at end of file
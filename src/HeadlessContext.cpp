@@ -0,0 +1,89 @@
+#include "HeadlessContext.hpp"
+
+#include <iostream>
+
+#ifdef __linux__
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#endif
+
+HeadlessContext::HeadlessContext()
+    : display_(nullptr),
+      context_(nullptr)
+{
+}
+
+#ifdef __linux__
+
+bool HeadlessContext::init() {
+    // Surfaceless platforma ne trazi X/Wayland; bez nje pokusava se podrazumevani display
+    EGLDisplay display = EGL_NO_DISPLAY;
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay)
+        display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (display == EGL_NO_DISPLAY)
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    EGLint major, minor;
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, &major, &minor)) {
+        std::cerr << "EGL init failed!\n";
+        return false;
+    }
+    display_ = display;
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        std::cerr << "EGL ne podrzava desktop OpenGL!\n";
+        destroy();
+        return false;
+    }
+
+    // Konfiguracija nije bitna jer nema povrsine; ako je nema, koristi se EGL_KHR_no_config_context
+    const EGLint configAttribs[] = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+    EGLConfig config = nullptr;
+    EGLint configCount = 0;
+    eglChooseConfig(display, configAttribs, &config, 1, &configCount);
+
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    EGLContext context = eglCreateContext(display, configCount > 0 ? config : EGL_NO_CONFIG_KHR,
+                                          EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT) {
+        std::cerr << "EGL context creation failed!\n";
+        destroy();
+        return false;
+    }
+    context_ = context;
+
+    if (!eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context)) {
+        std::cerr << "EGL surfaceless makeCurrent failed!\n";
+        destroy();
+        return false;
+    }
+    return true;
+}
+
+void HeadlessContext::destroy() {
+    if (display_) {
+        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (context_) eglDestroyContext(display_, context_);
+        eglTerminate(display_);
+    }
+    display_ = context_ = nullptr;
+}
+
+#else
+
+bool HeadlessContext::init() {
+    std::cerr << "Headless rezim je podrzan samo na Linux-u (EGL)!\n";
+    return false;
+}
+
+void HeadlessContext::destroy() {
+}
+
+#endif
\ No newline at end of file
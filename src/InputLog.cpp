@@ -0,0 +1,131 @@
+#include "InputLog.hpp"
+
+#include <cstring>
+#include <iostream>
+
+InputRecorder::InputRecorder()
+    : file_(nullptr)
+{
+}
+
+InputRecorder::~InputRecorder() {
+    close();
+}
+
+bool InputRecorder::open(const char* path, const InputLogHeader& header) {
+    close();
+    file_ = std::fopen(path, "wb");
+    if (!file_) {
+        std::cerr << "Ne moze da se pise snimak: " << path << "\n";
+        return false;
+    }
+
+    InputLogHeader h = header;
+    std::memcpy(h.magic, INPUT_LOG_MAGIC, sizeof(h.magic));
+    h.version = INPUT_LOG_VERSION;
+    write(&h, sizeof(h));
+    return true;
+}
+
+void InputRecorder::close() {
+    if (file_)
+        std::fclose(file_);
+    file_ = nullptr;
+}
+
+void InputRecorder::write(const void* data, std::size_t size) {
+    if (file_)
+        std::fwrite(data, 1, size, file_);
+}
+
+void InputRecorder::frame(double time) {
+    std::uint8_t type = INPUT_FRAME;
+    write(&type, 1);
+    write(&time, sizeof(time));
+}
+
+void InputRecorder::key(int key, int scancode, int action, int mods) {
+    std::uint8_t type = INPUT_KEY;
+    std::int32_t codes[2] = { key, scancode };
+    std::uint8_t flags[2] = { static_cast<std::uint8_t>(action), static_cast<std::uint8_t>(mods) };
+    write(&type, 1);
+    write(codes, sizeof(codes));
+    write(flags, sizeof(flags));
+}
+
+void InputRecorder::mouseButton(int button, int action, int mods) {
+    std::uint8_t record[4] = { INPUT_BUTTON, static_cast<std::uint8_t>(button),
+                               static_cast<std::uint8_t>(action), static_cast<std::uint8_t>(mods) };
+    write(record, sizeof(record));
+}
+
+void InputRecorder::cursor(double x, double y) {
+    std::uint8_t type = INPUT_CURSOR;
+    double position[2] = { x, y };
+    write(&type, 1);
+    write(position, sizeof(position));
+}
+
+bool InputReplay::load(const char* path) {
+    events_.clear();
+    frames_ = 0;
+
+    std::FILE* f = std::fopen(path, "rb");
+    if (!f) {
+        std::cerr << "Nema snimka: " << path << "\n";
+        return false;
+    }
+
+    bool ok = std::fread(&header_, sizeof(header_), 1, f) == 1 &&
+              std::memcmp(header_.magic, INPUT_LOG_MAGIC, sizeof(header_.magic)) == 0 &&
+              header_.version == INPUT_LOG_VERSION;
+
+    std::uint8_t type;
+    while (ok && std::fread(&type, 1, 1, f) == 1) {
+        InputEvent event;
+        event.type = static_cast<InputEventType>(type);
+
+        switch (type) {
+            case INPUT_FRAME:
+                ok = std::fread(&event.time, sizeof(event.time), 1, f) == 1;
+                ++frames_;
+                break;
+            case INPUT_KEY: {
+                std::int32_t codes[2];
+                std::uint8_t flags[2];
+                ok = std::fread(codes, sizeof(codes), 1, f) == 1 && std::fread(flags, sizeof(flags), 1, f) == 1;
+                event.key = codes[0];
+                event.scancode = codes[1];
+                event.action = flags[0];
+                event.mods = flags[1];
+                break;
+            }
+            case INPUT_BUTTON: {
+                std::uint8_t record[3];
+                ok = std::fread(record, sizeof(record), 1, f) == 1;
+                event.button = record[0];
+                event.action = record[1];
+                event.mods = record[2];
+                break;
+            }
+            case INPUT_CURSOR: {
+                double position[2];
+                ok = std::fread(position, sizeof(position), 1, f) == 1;
+                event.x = position[0];
+                event.y = position[1];
+                break;
+            }
+            default:
+                ok = false;
+                break;
+        }
+
+        if (ok)
+            events_.push_back(event);
+    }
+    std::fclose(f);
+
+    if (!ok)
+        std::cerr << "Neispravan snimak: " << path << "\n";
+    return ok;
+}
@@ -1,18 +1,570 @@
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
-#include <iostream>
-#include <thread>
+#include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include "SmartWatchApp.hpp"
+#include "FrameScheduler.hpp"
+#include "HeadlessContext.hpp"
+#include "SoftwareRasterizer.hpp"
+#include "AssetPack.hpp"
+#include "ProgramCache.hpp"
+#include "InputLog.hpp"
+#include "EcgSynth.hpp"
+#include "QrsDetector.hpp"
+#include "ThreadPool.hpp"
 
 static const int TARGET_FPS = 75;
 static const double FRAME_TIME = 1.0 / TARGET_FPS;
 
+// Pravi ga "make pack"; bez njega se slike dekodiraju iz PNG-ova
+static const char* ASSET_PACK = "res/assets.swpak";
+
+// Linkovani programi iz prethodnih pokretanja (vidi ProgramCache); pravi se sam
+static const char* PROGRAM_CACHE_DIR = "cache/programs";
+
+struct Options {
+    FramePolicy framePolicy = FramePolicy::Deadline;
+    bool headless = false;
+    bool softBench = false;
+    int width = 0;  // 0 - podrazumevano za izabrani rezim
+    int height = 0;
+    int frames = 600;
+    int threads = 0;
+    int headlessScreen = 0; // 0 sat, 1 srce, 2 baterija
+    int internalWidth = 0;  // 0 - crta se u rezoluciji izlaza
+    int internalHeight = 0;
+    GLenum upscaleFilter = GL_LINEAR;
+    bool programCache = true;
+    double simRate = WatchSimulation::DEFAULT_RATE;
+    int clockEpoch = WallClock::DEFAULT_EPOCH;
+    unsigned seed = 0;
+    bool fixedSeed = false;
+    double fastForward = 0.0;  // > 0: simulacija bez iscrtavanja toliko sekundi
+    double samplePeriod = 60.0;
+    std::vector<std::pair<double, double> > runs; // intervali [od, do) u kojima se drzi D
+    const char* outPath = nullptr;
+    const char* ecgSource = nullptr;  // EKG senzor, vidi EcgReader
+    const char* recordPath = nullptr; // prozor: snima ulaz i vremena frejmova
+    const char* replayPath = nullptr; // headless: pusta snimak
+    double qrsBench = 0.0;  // > 0: QRS detektor nad toliko sekundi signala po uredjaju
+    double ecgRate = 500.0;
+    int devices = 1;
+};
+
+// Korisnicki pokazivac prozora: aplikacija i, pri snimanju, snimak u koji idu svi dogadjaji
+struct WindowInput {
+    SmartWatchApp* app = nullptr;
+    InputRecorder recorder;
+};
+
 static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods);
 static void mouse_button_callback(GLFWwindow* window, int button, int action, int mods);
+static void cursor_pos_callback(GLFWwindow* window, double x, double y);
+
+static bool initGlew() {
+    GLenum err = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // GLEW preveden za GLX ne nalazi X display uz EGL, ali su GL funkcije tada vec ucitane
+    if (err == GLEW_ERROR_NO_GLX_DISPLAY) err = GLEW_OK;
+#endif
+    if (err != GLEW_OK) {
+        std::cerr << "GLEW init failed!\n";
+        return false;
+    }
+    return true;
+}
+
+// Trajanje: broj sa opcionom jedinicom s, m, h ili d ("90", "15m", "1.5h", "7d")
+static bool parseDuration(const char* text, double& outSeconds) {
+    char* end = nullptr;
+    double value = std::strtod(text, &end);
+    if (end == text || value < 0.0)
+        return false;
+
+    double unit = 1.0;
+    if (*end == 'm') unit = 60.0;
+    else if (*end == 'h') unit = 3600.0;
+    else if (*end == 'd') unit = 86400.0;
+    else if (*end != 's' && *end != '\0') return false;
+    if (*end != '\0' && end[1] != '\0')
+        return false;
+
+    outSeconds = value * unit;
+    return true;
+}
+
+// "od-do[,od-do...]", npr. "1h-1h10m,5h-5h30m"
+static bool parseRuns(const char* text, std::vector<std::pair<double, double> >& outRuns) {
+    std::string list(text);
+    std::size_t begin = 0;
+    while (begin <= list.size()) {
+        std::size_t end = list.find(',', begin);
+        if (end == std::string::npos) end = list.size();
+        std::string item = list.substr(begin, end - begin);
+        std::size_t dash = item.find('-');
+        double from, to;
+        if (dash == std::string::npos ||
+            !parseDuration(item.substr(0, dash).c_str(), from) ||
+            !parseDuration(item.substr(dash + 1).c_str(), to) || to <= from)
+            return false;
+        outRuns.push_back(std::make_pair(from, to));
+        begin = end + 1;
+    }
+    return true;
+}
+
+static bool parseOptions(int argc, char** argv, Options& outOptions) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = std::strchr(arg, '=');
+        value = value ? value + 1 : "";
+
+        if (std::strncmp(arg, "--frame-policy=", 15) == 0) {
+            if (!parseFramePolicy(value, outOptions.framePolicy)) return false;
+        } else if (std::strcmp(arg, "--headless") == 0) {
+            outOptions.headless = true;
+        } else if (std::strcmp(arg, "--soft-bench") == 0) {
+            outOptions.softBench = true;
+        } else if (std::strncmp(arg, "--qrs-bench", 11) == 0 && (arg[11] == '\0' || arg[11] == '=')) {
+            outOptions.qrsBench = 3600.0;
+            if (arg[11] == '=' && (!parseDuration(value, outOptions.qrsBench) || outOptions.qrsBench <= 0.0))
+                return false;
+        } else if (std::strncmp(arg, "--ecg-rate=", 11) == 0) {
+            outOptions.ecgRate = std::atof(value);
+            if (outOptions.ecgRate <= 0.0) return false;
+        } else if (std::strncmp(arg, "--devices=", 10) == 0) {
+            outOptions.devices = std::atoi(value);
+            if (outOptions.devices <= 0) return false;
+        } else if (std::strncmp(arg, "--size=", 7) == 0) {
+            if (std::sscanf(value, "%dx%d", &outOptions.width, &outOptions.height) != 2 ||
+                outOptions.width <= 0 || outOptions.height <= 0) return false;
+        } else if (std::strncmp(arg, "--frames=", 9) == 0) {
+            outOptions.frames = std::atoi(value);
+            if (outOptions.frames <= 0) return false;
+        } else if (std::strncmp(arg, "--threads=", 10) == 0) {
+            outOptions.threads = std::atoi(value);
+            if (outOptions.threads < 0) return false;
+        } else if (std::strncmp(arg, "--internal-res=", 15) == 0) {
+            if (std::sscanf(value, "%dx%d", &outOptions.internalWidth, &outOptions.internalHeight) != 2 ||
+                outOptions.internalWidth <= 0 || outOptions.internalHeight <= 0) return false;
+        } else if (std::strncmp(arg, "--upscale-filter=", 17) == 0) {
+            if (std::strcmp(value, "nearest") == 0)     outOptions.upscaleFilter = GL_NEAREST;
+            else if (std::strcmp(value, "linear") == 0) outOptions.upscaleFilter = GL_LINEAR;
+            else return false;
+        } else if (std::strncmp(arg, "--sim-rate=", 11) == 0) {
+            outOptions.simRate = std::atof(value);
+            if (outOptions.simRate <= 0.0) return false;
+        } else if (std::strncmp(arg, "--clock=", 8) == 0) {
+            if (std::strcmp(value, "system") == 0) outOptions.clockEpoch = WallClock::SYSTEM;
+            else if (!parseTimeOfDay(value, outOptions.clockEpoch)) return false;
+        } else if (std::strncmp(arg, "--seed=", 7) == 0) {
+            outOptions.seed = static_cast<unsigned>(std::strtoul(value, nullptr, 10));
+            outOptions.fixedSeed = true;
+        } else if (std::strncmp(arg, "--fast-forward=", 15) == 0) {
+            if (!parseDuration(value, outOptions.fastForward) || outOptions.fastForward <= 0.0) return false;
+        } else if (std::strncmp(arg, "--sample=", 9) == 0) {
+            if (!parseDuration(value, outOptions.samplePeriod) || outOptions.samplePeriod <= 0.0) return false;
+        } else if (std::strncmp(arg, "--run=", 6) == 0) {
+            if (!parseRuns(value, outOptions.runs)) return false;
+        } else if (std::strncmp(arg, "--out=", 6) == 0) {
+            if (!*value) return false;
+            outOptions.outPath = value;
+        } else if (std::strncmp(arg, "--ecg=", 6) == 0) {
+            if (!*value) return false;
+            outOptions.ecgSource = value;
+        } else if (std::strncmp(arg, "--record=", 9) == 0) {
+            if (!*value) return false;
+            outOptions.recordPath = value;
+        } else if (std::strncmp(arg, "--replay=", 9) == 0) {
+            if (!*value) return false;
+            outOptions.replayPath = value;
+        } else if (std::strcmp(arg, "--no-program-cache") == 0) {
+            outOptions.programCache = false;
+        } else if (std::strncmp(arg, "--screen=", 9) == 0) {
+            if (std::strcmp(value, "clock") == 0)        outOptions.headlessScreen = 0;
+            else if (std::strcmp(value, "heart") == 0)   outOptions.headlessScreen = 1;
+            else if (std::strcmp(value, "battery") == 0) outOptions.headlessScreen = 2;
+            else return false;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Headless kontekst i izlazni FBO width x height, vezan i spreman za crtanje
+static bool initHeadlessOutput(HeadlessContext& context, RenderTarget& output, int width, int height) {
+    if (!context.init())
+        return false;
+
+    if (!initGlew()) {
+        context.destroy();
+        return false;
+    }
+
+    if (!createRenderTarget(output, width, height)) {
+        std::cerr << "Greska pri pravljenju izlaznog FBO-a!\n";
+        context.destroy();
+        return false;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, output.fbo);
+    glViewport(0, 0, width, height);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    std::printf("Headless: %s, %s\n", glGetString(GL_VERSION), glGetString(GL_RENDERER));
+    return true;
+}
+
+// Vremena render() poziva koji su stvarno crtali
+struct RenderTimes {
+    int presented = 0;
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+
+    double averageMs() const { return presented ? totalMs / presented : 0.0; }
+};
+
+// Jedan headless frejm; glFinish da bi merenje obuhvatilo i GPU (odnosno llvmpipe) posao
+static void renderTimed(SmartWatchApp& app, const RenderTarget& output, RenderTimes& times) {
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    glBindFramebuffer(GL_FRAMEBUFFER, output.fbo);
+    bool drawn = app.render();
+    glFinish();
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    if (drawn) {
+        ++times.presented;
+        times.totalMs += ms;
+        if (ms > times.maxMs) times.maxMs = ms;
+    }
+}
+
+static bool checkGlError() {
+    GLenum err = glGetError();
+    if (err != GL_NO_ERROR) {
+        std::cerr << "GL greska: 0x" << std::hex << err << std::dec << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Bez prozora: crta u FBO sa fiksnim korakom simuliranog vremena i meri vreme render() poziva
+static int runHeadless(const Options& options) {
+    const int width = options.width ? options.width : 800;
+    const int height = options.height ? options.height : 450;
+
+    HeadlessContext context;
+    RenderTarget output;
+    if (!initHeadlessOutput(context, output, width, height))
+        return -1;
+
+    int result = 0;
+    {
+        SmartWatchApp app;
+        app.setInternalResolution(options.internalWidth, options.internalHeight, options.upscaleFilter);
+        app.setSimulationRate(options.simRate);
+        app.setClockEpoch(options.clockEpoch);
+        app.setSeed(options.seed);
+        app.setEcgSource(options.ecgSource);
+        if (!app.init(nullptr, width, height)) {
+            destroyRenderTarget(output);
+            context.destroy();
+            return -1;
+        }
+
+        // Do zeljenog ekrana se stize klikom na desnu strelicu, kao u prozoru
+        app.onCursorPos(width - 1.0, height / 2.0);
+        for (int i = 0; i < options.headlessScreen; ++i)
+            app.onMouseButton(GLFW_MOUSE_BUTTON_LEFT, GLFW_PRESS, 0);
+        app.onCursorPos(width / 2.0, height / 2.0);
+
+        RenderTimes times;
+        for (int frame = 0; frame < options.frames; ++frame) {
+            app.update(frame * FRAME_TIME);
+            renderTimed(app, output, times);
+        }
+
+        if (!checkGlError())
+            result = -1;
+
+        std::printf("Headless %dx%d: %d frejmova, %d iscrtano, render %.3f ms prosek, %.3f ms max\n",
+                    width, height, options.frames, times.presented, times.averageMs(), times.maxMs);
+        app.printEcgStats();
+    }
+
+    destroyRenderTarget(output);
+    context.destroy();
+    return result;
+}
+
+// Pusta snimak (--record) bez prozora i bez cekanja izmedju frejmova: isto seme, isti ulaz i ista
+// vremena frejmova daju isti posao, pa se merenja razlicitih verzija mogu porediti
+static int runReplay(const Options& options) {
+    InputReplay replay;
+    if (!replay.load(options.replayPath))
+        return -1;
+    const InputLogHeader& header = replay.header();
+
+    // Izlaz je velicine snimljenog prozora, da bi koordinate kursora imale isto znacenje
+    HeadlessContext context;
+    RenderTarget output;
+    if (!initHeadlessOutput(context, output, header.width, header.height))
+        return -1;
+
+    int result = 0;
+    {
+        SmartWatchApp app;
+        app.setInternalResolution(options.internalWidth, options.internalHeight, options.upscaleFilter);
+        app.setSimulationRate(header.simRate);
+        app.setClockEpoch(header.clockEpoch);
+        app.setSeed(header.seed);
+        app.setStartTime(header.startTime);
+        if (!app.init(nullptr, header.width, header.height)) {
+            destroyRenderTarget(output);
+            context.destroy();
+            return -1;
+        }
+
+        typedef std::chrono::steady_clock Clock;
+        Clock::time_point start = Clock::now();
+        RenderTimes times;
+
+        for (const InputEvent& event : replay.events()) {
+            switch (event.type) {
+                case INPUT_FRAME:
+                    app.update(event.time);
+                    renderTimed(app, output, times);
+                    break;
+                case INPUT_KEY:    app.onKey(event.key, event.scancode, event.action, event.mods); break;
+                case INPUT_BUTTON: app.onMouseButton(event.button, event.action, event.mods); break;
+                case INPUT_CURSOR: app.onCursorPos(event.x, event.y); break;
+            }
+        }
+
+        double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (!checkGlError())
+            result = -1;
+
+        std::printf("Replay %s (%dx%d, seme %u): %d frejmova, %d iscrtano, render %.3f ms prosek, "
+                    "%.3f ms max, ukupno %.1f ms\n",
+                    options.replayPath, header.width, header.height, header.seed, replay.frameCount(),
+                    times.presented, times.averageMs(), times.maxMs, totalMs);
+    }
+
+    destroyRenderTarget(output);
+    context.destroy();
+    return result;
+}
+
+// CPU rasterizer bez GL-a: ekran srca (EKG, strelice, kursor, overlay) plus punjenje baterije,
+// iste pozicije kao u SmartWatchApp; meri prosecno vreme frejma
+static int runSoftBench(const Options& options) {
+    const int width = options.width ? options.width : 454;
+    const int height = options.height ? options.height : 454;
 
-int main() {
+    SoftTexture pages[kAtlasPageCount], ekg;
+    for (int i = 0; i < kAtlasPageCount; ++i) {
+        if (!loadSoftTexture(pages[i], kAtlasPages[i], false, kAtlasPageChannels[i] == 1))
+            return -1;
+    }
+    if (!loadSoftTexture(ekg, "res/ekg.png", true))
+        return -1;
+
+    SoftwareRasterizer raster;
+    if (!raster.init(width, height, options.threads)) {
+        std::cerr << "Neispravna velicina framebuffer-a!\n";
+        return -1;
+    }
+
+    auto sprite = [&](SpriteId id, float x, float y, float w, float h, float a) {
+        const AtlasRegion& region = kAtlasRegions[static_cast<int>(id)];
+        raster.drawSprite(pages[region.page], region, x, y, w, h, 1.0f, 1.0f, 1.0f, a);
+    };
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    double maxMs = 0.0;
+
+    for (int frame = 0; frame < options.frames; ++frame) {
+        Clock::time_point frameStart = Clock::now();
+        float t = static_cast<float>(frame * FRAME_TIME);
+
+        raster.clear(0.8f, 0.8f, 0.8f, 1.0f);
+        sprite(SpriteId::ArrowLeft,  -0.85f, 0.0f, 0.08f, 0.08f, 1.0f);
+        sprite(SpriteId::ArrowRight,  0.85f, 0.0f, 0.08f, 0.08f, 1.0f);
+        raster.drawQuad(&ekg, 0.0f, 0.0f, 0.7f, 0.4f, t * 0.7f, 0.0f, 1.7f, 1.0f);
+        sprite(SpriteId::BatteryFrame, 0.0f, -0.7f, 0.25f, 0.2f, 1.0f);
+        raster.drawBatteryQuad(0.0125f, -0.7f, 0.2f, 0.075f, 1.0f - std::fmod(t * 0.1f, 1.0f));
+        sprite(SpriteId::Heart, std::sin(t) * 0.5f, std::cos(t) * 0.5f, 0.06f, 0.06f, 1.0f);
+        sprite(SpriteId::IdOverlay, 0.7f, 0.84f, 0.28f, 0.12f, 0.6f);
+        raster.flush();
+
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+        if (ms > maxMs) maxMs = ms;
+    }
+
+    double totalMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    double avgMs = totalMs / options.frames;
+    std::printf("Soft raster %dx%d (%s, %d niti): %d frejmova, %.3f ms prosek, %.3f ms max, %.0f fps\n",
+                width, height, raster.kernelName(), raster.threadCount(), options.frames,
+                avgMs, maxMs, avgMs > 0.0 ? 1000.0 / avgMs : 0.0);
+
+    raster.destroy();
+    return 0;
+}
+
+// Detektor QRS-a bez GL-a nad virtuelnim pacijentima: svaki uredjaj ima svoj EcgSynth (seme i
+// BPM iz rednog broja, pa je opterecenje uvek isto) i svoj QrsDetector. Signal se sintetise
+// unapred i daje detektoru u blokovima od 64 uzorka, kao iz simulacije. Uredjaji se dele na niti;
+// meri se propusnost detektora u uzorcima po sekundi, po jezgru i ukupno.
+static int runQrsBench(const Options& options) {
+    const double rate = options.ecgRate;
+    const std::size_t count = static_cast<std::size_t>(options.qrsBench * rate);
+    const int block = 64;
+
+    ThreadPool pool;
+    pool.init(options.threads);
+    std::vector<double> synthSeconds(options.devices), detectSeconds(options.devices);
+    std::vector<std::uint64_t> synthBeats(options.devices), detectedBeats(options.devices);
+    std::vector<double> synthBpm(options.devices), detectedBpm(options.devices);
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    pool.parallelFor(options.devices, [&](int device) {
+        EcgSynthParams params;
+        params.sampleRate = rate;
+        params.bpm = 50.0 + (device * 37) % 130;
+        params.seed = static_cast<unsigned>(device);
+        EcgSynth synth;
+        synth.init(params);
+
+        Clock::time_point synthStart = Clock::now();
+        std::vector<float> signal(count);
+        synth.generate(signal.data(), count);
+        Clock::time_point detectStart = Clock::now();
+
+        QrsDetector detector;
+        detector.init(rate);
+        for (std::size_t i = 0; i < count; i += block)
+            detector.process(signal.data() + i, static_cast<int>(std::min<std::size_t>(block, count - i)));
+
+        detectSeconds[device] = std::chrono::duration<double>(Clock::now() - detectStart).count();
+        synthSeconds[device] = std::chrono::duration<double>(detectStart - synthStart).count();
+        synthBeats[device] = synth.beats();
+        detectedBeats[device] = detector.beats();
+        synthBpm[device] = synth.meanBpm();
+        detectedBpm[device] = detector.bpm();
+    });
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    double synthTotal = 0.0, detectTotal = 0.0;
+    std::uint64_t expected = 0, detected = 0;
+    for (int device = 0; device < options.devices; ++device) {
+        synthTotal += synthSeconds[device];
+        detectTotal += detectSeconds[device];
+        expected += synthBeats[device];
+        detected += detectedBeats[device];
+    }
+    double samples = static_cast<double>(count) * options.devices;
+
+    std::printf("QRS (%s, %.0f Hz): %d uredjaja x %.0f s signala, %d niti, %.1f ms ukupno\n"
+                "  detektor: %.2f M uzoraka/s po jezgru; sinteza: %.2f M uzoraka/s po jezgru; "
+                "sve zajedno %.2f M uzoraka/s\n"
+                "  otkucaja: %llu otkriveno, %llu sintetisano\n"
+                "  BPM (uredjaj 0): %.1f otkriveno (poslednji R-R intervali), %.1f stvarni prosek\n",
+                QrsDetector::kernelName(), rate, options.devices, options.qrsBench, pool.threadCount(),
+                seconds * 1000.0, samples / detectTotal / 1e6, samples / synthTotal / 1e6, samples / seconds / 1e6,
+                static_cast<unsigned long long>(detected), static_cast<unsigned long long>(expected),
+                detectedBpm[0], synthBpm[0]);
+
+    pool.destroy();
+    return 0;
+}
+
+// Model sata (baterija, BPM, trcanje, vreme) bez prozora i bez GL-a, sto brze moze: izmedju
+// rokova se koraci preskacu (WatchSimulation::fastForward). Vremenska serija ide u CSV.
+static int runFastForward(const Options& options) {
+    std::FILE* out = options.outPath ? std::fopen(options.outPath, "w") : stdout;
+    if (!out) {
+        std::cerr << "Ne moze da se pise " << options.outPath << "\n";
+        return -1;
+    }
+
+    WallClock clock;
+    int epoch = options.clockEpoch;
+    if (epoch == WallClock::SYSTEM) {
+        clock.init(WallClock::SYSTEM, 0.0);
+        epoch = clock.secondOfDay(0.0);
+    }
+    clock.init(epoch, 0.0);
+
+    WatchSimulation sim;
+    sim.init(0.0, options.simRate, options.seed);
+
+    // Granice: uzorci (true) i pocetak/kraj svakog trcanja; izmedju njih ulaz se ne menja
+    std::vector<std::pair<double, bool> > stops;
+    for (double t = options.samplePeriod; t < options.fastForward; t += options.samplePeriod)
+        stops.push_back(std::make_pair(t, true));
+    for (const std::pair<double, double>& run : options.runs) {
+        if (run.first < options.fastForward)  stops.push_back(std::make_pair(run.first, false));
+        if (run.second < options.fastForward) stops.push_back(std::make_pair(run.second, false));
+    }
+    stops.push_back(std::make_pair(options.fastForward, true));
+    std::sort(stops.begin(), stops.end());
+
+    auto runningAt = [&](double t) {
+        for (const std::pair<double, double>& run : options.runs)
+            if (t >= run.first && t < run.second)
+                return true;
+        return false;
+    };
+
+    auto sample = [&](const WatchState& state) {
+        TimeOfDay tod = TimeOfDay::fromSecond(clock.secondOfDay(state.time));
+        std::fprintf(out, "%.3f,%02d:%02d:%02d,%.0f,%.2f,%.2f,%d\n",
+                     state.time, tod.hh, tod.mm, tod.ss, state.batteryLevel * 100.0f,
+                     state.bpm, state.bpmTarget, state.running ? 1 : 0);
+    };
+
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    std::uint64_t steps = 0;
+
+    std::fprintf(out, "t_s,clock,battery_pct,bpm,bpm_target,running\n");
+    sample(sim.current());
+
+    double t = 0.0;
+    for (const std::pair<double, bool>& stop : stops) {
+        sim.setRunning(runningAt(t));
+        steps += sim.fastForward(stop.first - sim.current().time);
+        t = stop.first;
+        if (stop.second)
+            sample(sim.current());
+    }
+
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    if (out != stdout)
+        std::fclose(out);
+
+    std::fprintf(stderr, "Fast-forward %.0f s (seme %u): %llu koraka, %.1f ms, %.2e simuliranih s/s\n",
+                 options.fastForward, options.seed, static_cast<unsigned long long>(steps), ms,
+                 ms > 0.0 ? options.fastForward / (ms / 1000.0) : 0.0);
+    return 0;
+}
+
+static int runWindowed(const Options& options) {
     if (!glfwInit()) {
         std::cerr << "GLFW init failed!\n";
         return -1;
@@ -36,8 +588,7 @@ int main() {
 
     glfwMakeContextCurrent(window);
 
-    if (glewInit() != GLEW_OK) {
-        std::cerr << "GLEW init failed!\n";
+    if (!initGlew()) {
         glfwTerminate();
         return -1;
     }
@@ -45,58 +596,144 @@ int main() {
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
+    // Snimak mora da se pusti bez prozora, pa se i ovde sve racuna iz vremena frejmova, a
+    // sistemski sat se snima kao simulirani koji krece od trenutnog vremena
+    bool recording = options.recordPath != nullptr;
+    int clockEpoch = options.clockEpoch;
+    if (recording && clockEpoch == WallClock::SYSTEM) {
+        WallClock systemClock;
+        systemClock.init(WallClock::SYSTEM, 0.0);
+        clockEpoch = systemClock.secondOfDay(0.0);
+    }
+
     SmartWatchApp app;
+    app.setInternalResolution(options.internalWidth, options.internalHeight, options.upscaleFilter);
+    app.setSimulationRate(options.simRate);
+    app.setClockEpoch(clockEpoch);
+    app.setSeed(options.seed);
+    app.setDeterministic(recording);
+    app.setEcgSource(options.ecgSource);
     if (!app.init(window, screenWidth, screenHeight)) {
+        app.shutdown();
         glfwTerminate();
         return -1;
     }
 
-    glfwSetWindowUserPointer(window, &app);
+    WindowInput input;
+    input.app = &app;
+    if (recording) {
+        InputLogHeader header = {};
+        header.seed = options.seed;
+        header.clockEpoch = clockEpoch;
+        header.simRate = options.simRate;
+        header.startTime = app.startTime();
+        header.width = screenWidth;
+        header.height = screenHeight;
+        if (!input.recorder.open(options.recordPath, header)) {
+            app.shutdown();
+            glfwTerminate();
+            return -1;
+        }
+    }
+
+    glfwSetWindowUserPointer(window, &input);
     glfwSetKeyCallback(window, key_callback);
     glfwSetMouseButtonCallback(window, mouse_button_callback);
+    glfwSetCursorPosCallback(window, cursor_pos_callback);
 
-    while (!glfwWindowShouldClose(window)) {
-        double frameStart = glfwGetTime();
+    // Kursor stize samo kroz callback (i u snimak); pocetni polozaj ide istim putem
+    double cursorX, cursorY;
+    glfwGetCursorPos(window, &cursorX, &cursorY);
+    cursor_pos_callback(window, cursorX, cursorY);
 
-        glfwPollEvents();
+    FrameScheduler scheduler;
+    scheduler.init(options.framePolicy, FRAME_TIME);
+
+    while (!glfwWindowShouldClose(window)) {
+        scheduler.waitForFrame(app.idleTimeout(glfwGetTime()));
 
         double currentTime = glfwGetTime();
+        if (recording)
+            input.recorder.frame(currentTime);
         app.update(currentTime);
-        app.render();
-
-        glfwSwapBuffers(window);
 
-        // Frame limiter
-        double frameEnd = glfwGetTime();
-        double elapsed = frameEnd - frameStart;
-        double toWait  = FRAME_TIME - elapsed;
+        // Ako se nista nije promenilo, prethodni frejm ostaje na ekranu
+        bool presented = app.render();
+        if (presented)
+            glfwSwapBuffers(window);
 
-        if (toWait > 0.0) {
-            auto sleepMs = static_cast<int>((toWait - 0.001) * 1000.0);
-            if (sleepMs > 0) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(sleepMs));
-            }
-            while ((glfwGetTime() - frameStart) < FRAME_TIME) {
-                // busy wait
-            }
-        }
+        scheduler.frameDone(presented);
     }
 
+    scheduler.printStats();
+    app.printEcgStats();
+    input.recorder.close();
+
+    app.shutdown();
     glfwDestroyWindow(window);
     glfwTerminate();
     return 0;
 }
 
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Upotreba: " << argv[0] << " [--frame-policy=ondemand|vsync|deadline] [--internal-res=454x454] "
+                                              "[--upscale-filter=linear|nearest] [--sim-rate=250] [--clock=system|HH:MM:SS] "
+                                              "[--record=snimak.swrl] [--ecg=fajl|fifo|unix:/socket] [--no-program-cache]\n"
+                  << "       " << argv[0] << " --headless [--size=800x450] [--frames=600] "
+                                             "[--screen=clock|heart|battery] [--internal-res=WxH] [--sim-rate=250] [--clock=system|HH:MM:SS] "
+                                             "[--no-program-cache]\n"
+                  << "       " << argv[0] << " --replay=snimak.swrl [--internal-res=WxH] [--no-program-cache]\n"
+                  << "       " << argv[0] << " --fast-forward=7d [--sample=1h] [--run=1h-1h30m,...] "
+                                             "[--clock=HH:MM:SS] [--seed=N] [--sim-rate=250] [--out=serija.csv]\n"
+                  << "       " << argv[0] << " --soft-bench [--size=454x454] [--frames=600] [--threads=0]\n"
+                  << "       " << argv[0] << " --qrs-bench[=1h] [--ecg-rate=500] [--devices=1] [--threads=0]\n";
+        return -1;
+    }
+
+    if (options.softBench)
+        return runSoftBench(options);
+    if (options.qrsBench > 0.0)
+        return runQrsBench(options);
+
+    if (!options.fixedSeed)
+        options.seed = static_cast<unsigned>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
+    if (options.fastForward > 0.0)
+        return runFastForward(options);
+
+    if (assetPack().open(ASSET_PACK))
+        std::cout << "Teksture se ucitavaju iz " << ASSET_PACK << "\n";
+    if (options.programCache)
+        programCache().setDirectory(PROGRAM_CACHE_DIR);
+    if (options.replayPath)
+        return runReplay(options);
+    return options.headless ? runHeadless(options) : runWindowed(options);
+}
+
 static void key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
-    auto* app = static_cast<SmartWatchApp*>(glfwGetWindowUserPointer(window));
-    if (app) {
-        app->onKey(key, scancode, action, mods);
+    auto* input = static_cast<WindowInput*>(glfwGetWindowUserPointer(window));
+    if (input) {
+        if (input->recorder.isOpen())
+            input->recorder.key(key, scancode, action, mods);
+        input->app->onKey(key, scancode, action, mods);
     }
 }
 
 static void mouse_button_callback(GLFWwindow* window, int button, int action, int mods) {
-    auto* app = static_cast<SmartWatchApp*>(glfwGetWindowUserPointer(window));
-    if (app) {
-        app->onMouseButton(button, action, mods);
+    auto* input = static_cast<WindowInput*>(glfwGetWindowUserPointer(window));
+    if (input) {
+        if (input->recorder.isOpen())
+            input->recorder.mouseButton(button, action, mods);
+        input->app->onMouseButton(button, action, mods);
+    }
+}
+
+static void cursor_pos_callback(GLFWwindow* window, double x, double y) {
+    auto* input = static_cast<WindowInput*>(glfwGetWindowUserPointer(window));
+    if (input) {
+        if (input->recorder.isOpen())
+            input->recorder.cursor(x, y);
+        input->app->onCursorPos(x, y);
     }
 }
\ No newline at end of file
@@ -0,0 +1,153 @@
+#include "ProgramCache.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+const char CACHE_MAGIC[4] = { 'S', 'W', 'P', 'B' };
+const std::uint32_t CACHE_VERSION = 1;
+
+// Zaglavlje fajla; iza njega ide length bajtova binarnog programa
+struct CacheHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t key;
+    std::uint32_t binaryFormat;
+    std::uint32_t length;
+};
+
+const std::uint64_t FNV_OFFSET = 14695981039346656037ull;
+const std::uint64_t FNV_PRIME = 1099511628211ull;
+
+void hashBytes(std::uint64_t& hash, const void* data, std::size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+}
+
+// Ukljucuje i zavrsnu nulu, pa "ab" + "c" i "a" + "bc" daju razlicit hes
+void hashString(std::uint64_t& hash, const char* text) {
+    hashBytes(hash, text ? text : "", std::strlen(text ? text : "") + 1);
+}
+
+} // namespace
+
+ProgramCache& programCache() {
+    static ProgramCache cache;
+    return cache;
+}
+
+std::uint64_t ProgramCache::key(const std::string& vertexSource, const std::string& fragmentSource) const {
+    if (!enabled() || !(GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary))
+        return 0;
+
+    // Neki drajveri izlazu prosirenje, a ne nude ni jedan binarni format
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    if (formats <= 0)
+        return 0;
+
+    std::uint64_t hash = FNV_OFFSET;
+    hashString(hash, vertexSource.c_str());
+    hashString(hash, fragmentSource.c_str());
+    hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+    hashString(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+    hashString(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+    return hash ? hash : 1;
+}
+
+std::string ProgramCache::path(std::uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return directory_ + "/" + name;
+}
+
+GLuint ProgramCache::load(std::uint64_t key) const {
+    if (!key)
+        return 0;
+
+    std::string filePath = path(key);
+    std::FILE* f = std::fopen(filePath.c_str(), "rb");
+    if (!f)
+        return 0;
+
+    CacheHeader header;
+    std::vector<unsigned char> binary;
+    bool ok = std::fread(&header, sizeof(header), 1, f) == 1 &&
+              std::memcmp(header.magic, CACHE_MAGIC, 4) == 0 && header.version == CACHE_VERSION &&
+              header.key == key && header.length > 0;
+    if (ok) {
+        binary.resize(header.length);
+        ok = std::fread(binary.data(), 1, binary.size(), f) == binary.size();
+    }
+    std::fclose(f);
+
+    GLuint program = 0;
+    GLint linked = GL_FALSE;
+    if (ok) {
+        program = glCreateProgram();
+        glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+        glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    }
+
+    // Ostecen fajl ili binarni oblik koji drajver vise ne prihvata - brise se i prevodi se iznova
+    if (linked == GL_FALSE) {
+        if (program)
+            glDeleteProgram(program);
+        std::cout << "Kes programa je neispravan, sejder se prevodi: " << filePath << "\n";
+        std::remove(filePath.c_str());
+        return 0;
+    }
+    return program;
+}
+
+void ProgramCache::prepare(GLuint program, std::uint64_t key) const {
+    if (key)
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void ProgramCache::store(GLuint program, std::uint64_t key) const {
+    if (!key)
+        return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    std::vector<unsigned char> binary(static_cast<std::size_t>(length));
+    GLenum binaryFormat = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(program, length, &written, &binaryFormat, binary.data());
+    if (written <= 0)
+        return;
+
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+
+    CacheHeader header;
+    std::memcpy(header.magic, CACHE_MAGIC, 4);
+    header.version = CACHE_VERSION;
+    header.key = key;
+    header.binaryFormat = binaryFormat;
+    header.length = static_cast<std::uint32_t>(written);
+
+    // Upis u privremeni fajl pa preimenovanje - drugi proces nikad ne vidi pola fajla
+    std::string filePath = path(key);
+    std::string tempPath = filePath + ".tmp";
+    std::FILE* f = std::fopen(tempPath.c_str(), "wb");
+    if (!f)
+        return;
+    bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1 &&
+              std::fwrite(binary.data(), 1, static_cast<std::size_t>(written), f) == static_cast<std::size_t>(written);
+    ok = std::fclose(f) == 0 && ok;
+
+    if (!ok || std::rename(tempPath.c_str(), filePath.c_str()) != 0)
+        std::remove(tempPath.c_str());
+}
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include "QrsDetector.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define QRS_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define QRS_AVX2 1
+#include <immintrin.h>
+#endif
+#endif
+
+namespace {
+
+const double PI = 3.14159265358979323846;
+
+// y[i] = sum(h[k] * x[i + k]), po zelji na kvadrat. Svi kerneli sabiraju po k rastuce i bez
+// FMA, pa su rezultati isti do bita.
+typedef void (*FirFn)(const float* x, const float* h, int taps, float* y, int count, bool square);
+
+void firScalar(const float* x, const float* h, int taps, float* y, int count, bool square) {
+    for (int i = 0; i < count; ++i) {
+        float acc = 0.0f;
+        for (int k = 0; k < taps; ++k)
+            acc += h[k] * x[i + k];
+        y[i] = square ? acc * acc : acc;
+    }
+}
+
+#ifdef QRS_SSE2
+
+// Osam izlaza po prolazu (dva akumulatora), ostatak skalarno
+void firSse2(const float* x, const float* h, int taps, float* y, int count, bool square) {
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128 acc0 = _mm_setzero_ps();
+        __m128 acc1 = _mm_setzero_ps();
+        for (int k = 0; k < taps; ++k) {
+            __m128 coeff = _mm_set1_ps(h[k]);
+            acc0 = _mm_add_ps(acc0, _mm_mul_ps(coeff, _mm_loadu_ps(x + i + k)));
+            acc1 = _mm_add_ps(acc1, _mm_mul_ps(coeff, _mm_loadu_ps(x + i + k + 4)));
+        }
+        if (square) {
+            acc0 = _mm_mul_ps(acc0, acc0);
+            acc1 = _mm_mul_ps(acc1, acc1);
+        }
+        _mm_storeu_ps(y + i, acc0);
+        _mm_storeu_ps(y + i + 4, acc1);
+    }
+    firScalar(x + i, h, taps, y + i, count - i, square);
+}
+
+#endif
+
+#ifdef QRS_AVX2
+
+// Isto kao SSE2 kernel, 16 izlaza po prolazu
+__attribute__((target("avx2")))
+void firAvx2(const float* x, const float* h, int taps, float* y, int count, bool square) {
+    int i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m256 acc0 = _mm256_setzero_ps();
+        __m256 acc1 = _mm256_setzero_ps();
+        for (int k = 0; k < taps; ++k) {
+            __m256 coeff = _mm256_set1_ps(h[k]);
+            acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(coeff, _mm256_loadu_ps(x + i + k)));
+            acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(coeff, _mm256_loadu_ps(x + i + k + 8)));
+        }
+        if (square) {
+            acc0 = _mm256_mul_ps(acc0, acc0);
+            acc1 = _mm256_mul_ps(acc1, acc1);
+        }
+        _mm256_storeu_ps(y + i, acc0);
+        _mm256_storeu_ps(y + i + 8, acc1);
+    }
+    firScalar(x + i, h, taps, y + i, count - i, square);
+}
+
+#endif
+
+struct Kernel {
+    FirFn fn;
+    const char* name;
+};
+
+Kernel selectKernel() {
+    const char* forced = std::getenv("QRS_KERNEL");
+    std::string limit = forced ? forced : "";
+
+    if (limit == "scalar")
+        return { firScalar, "scalar" };
+#ifdef QRS_AVX2
+    __builtin_cpu_init();
+    if (limit != "sse2" && __builtin_cpu_supports("avx2"))
+        return { firAvx2, "avx2" };
+#endif
+#ifdef QRS_SSE2
+    return { firSse2, "sse2" };
+#else
+    return { firScalar, "scalar" };
+#endif
+}
+
+const Kernel& kernel() {
+    static const Kernel selected = selectKernel();
+    return selected;
+}
+
+// Niskopropusni windowed-sinc (Hamming), k = -half..half
+double lowPass(double cutoff, double sampleRate, int k) {
+    double fc = cutoff / sampleRate;
+    return k == 0 ? 2.0 * fc : std::sin(2.0 * PI * fc * k) / (PI * k);
+}
+
+} // namespace
+
+QrsDetector::QrsDetector() {
+    init(250.0);
+}
+
+const char* QrsDetector::kernelName() {
+    return kernel().name;
+}
+
+void QrsDetector::init(double sampleRate) {
+    sampleRate_ = sampleRate;
+
+    // Propusnik 5-15 Hz; pola sekunde odziva je dovoljno usko za QRS opseg na svim ucestanostima
+    int half = std::max(2, static_cast<int>(std::lround(0.25 * sampleRate)));
+    int bandTaps = 2 * half + 1;
+    std::vector<double> band(bandTaps);
+    for (int k = -half; k <= half; ++k) {
+        double window = 0.54 - 0.46 * std::cos(2.0 * PI * (k + half) / (bandTaps - 1));
+        band[k + half] = (lowPass(15.0, sampleRate, k) - lowPass(5.0, sampleRate, k)) * window;
+    }
+
+    // Jedinicno pojacanje na 10 Hz
+    double re = 0.0, im = 0.0;
+    for (int j = 0; j < bandTaps; ++j) {
+        re += band[j] * std::cos(2.0 * PI * 10.0 * j / sampleRate);
+        im -= band[j] * std::sin(2.0 * PI * 10.0 * j / sampleRate);
+    }
+    double gain = std::sqrt(re * re + im * im);
+
+    // Izvod iz Pan-Tompkins-a: (2x[n] + x[n-1] - x[n-3] - 2x[n-4]) * fs / 8, spojen sa propusnikom
+    const double derivative[5] = { 2.0, 1.0, 0.0, -1.0, -2.0 };
+    int taps = bandTaps + 4;
+    std::vector<double> combined(taps, 0.0);
+    for (int j = 0; j < bandTaps; ++j)
+        for (int d = 0; d < 5; ++d)
+            combined[j + d] += band[j] / gain * derivative[d] * sampleRate / 8.0;
+
+    // Prozor x[i..i+taps-1] se zavrsava tekucim uzorkom, pa koeficijenti idu obrnutim redom
+    bandTaps_.resize(taps);
+    for (int k = 0; k < taps; ++k)
+        bandTaps_[k] = static_cast<float>(combined[taps - 1 - k]);
+
+    int windowTaps = std::max(1, static_cast<int>(std::lround(0.15 * sampleRate)));
+    windowTaps_.assign(windowTaps, 1.0f / windowTaps);
+
+    input_.assign(taps - 1 + BLOCK, 0.0f);
+    squared_.assign(windowTaps - 1 + BLOCK, 0.0f);
+    integrated_.assign(BLOCK, 0.0f);
+    delay_ = (taps - 1) / 2 + (windowTaps - 1) / 2;
+
+    index_ = 0;
+    prev_[0] = prev_[1] = 0.0f;
+    learning_ = static_cast<int>(2.0 * sampleRate);
+    learnMax_ = 0.0f;
+    learnSum_ = 0.0;
+    signalPeak_ = 0.0f;
+    noisePeak_ = 0.0f;
+    refractory_ = static_cast<int>(0.2 * sampleRate);
+    lastBeat_ = 0;
+    beats_ = 0;
+    searchPeak_ = 0.0f;
+    searchIndex_ = 0;
+    rrCount_ = 0;
+}
+
+int QrsDetector::process(const float* samples, int count) {
+    std::uint64_t before = beats_;
+    const int bandHistory = static_cast<int>(bandTaps_.size()) - 1;
+    const int windowHistory = static_cast<int>(windowTaps_.size()) - 1;
+    FirFn fir = kernel().fn;
+
+    while (count > 0) {
+        int n = std::min(count, static_cast<int>(BLOCK));
+        std::memcpy(input_.data() + bandHistory, samples, n * sizeof(float));
+
+        fir(input_.data(), bandTaps_.data(), bandHistory + 1, squared_.data() + windowHistory, n, true);
+        fir(squared_.data(), windowTaps_.data(), windowHistory + 1, integrated_.data(), n, false);
+        detect(integrated_.data(), n);
+
+        std::memmove(input_.data(), input_.data() + n, bandHistory * sizeof(float));
+        std::memmove(squared_.data(), squared_.data() + n, windowHistory * sizeof(float));
+        samples += n;
+        count -= n;
+    }
+    return static_cast<int>(beats_ - before);
+}
+
+void QrsDetector::detect(const float* integrated, int count) {
+    for (int i = 0; i < count; ++i, ++index_) {
+        float value = integrated[i];
+
+        if (learning_ > 0) {
+            // Prve dve sekunde samo odredjuju pocetne pragove
+            learnMax_ = std::max(learnMax_, value);
+            learnSum_ += value;
+            if (--learning_ == 0) {
+                signalPeak_ = learnMax_ / 3.0f;
+                noisePeak_ = static_cast<float>(0.5 * learnSum_ / (2.0 * sampleRate_));
+            }
+        } else if (prev_[1] < prev_[0] && prev_[0] >= value) {
+            // Vrh je prethodni uzorak
+            std::uint64_t peakIndex = index_ - 1;
+            float peak = prev_[0];
+            float threshold1 = noisePeak_ + 0.25f * (signalPeak_ - noisePeak_);
+            float threshold2 = 0.5f * threshold1;
+
+            if (beats_ > 0 && peakIndex - lastBeat_ < static_cast<std::uint64_t>(refractory_)) {
+                // Isti QRS ili T talas odmah posle njega
+            } else if (peak > threshold1) {
+                signalPeak_ = 0.125f * peak + 0.875f * signalPeak_;
+                acceptBeat(peakIndex, peak);
+            } else {
+                noisePeak_ = 0.125f * peak + 0.875f * noisePeak_;
+                if (peak > threshold2 && peak > searchPeak_) {
+                    searchPeak_ = peak;
+                    searchIndex_ = peakIndex;
+                }
+            }
+        }
+
+        // Pretraga unazad: bez otkucaja 166% prosecnog RR-a uzima se najveci odbaceni vrh iznad praga 2
+        if (rrCount_ > 0 && searchPeak_ > 0.0f) {
+            double rrMean = 0.0;
+            int n = std::min(rrCount_, static_cast<int>(RR_HISTORY));
+            for (int r = 0; r < n; ++r) rrMean += rr_[r];
+            rrMean /= n;
+            if (static_cast<double>(index_ - lastBeat_) > 1.66 * rrMean) {
+                signalPeak_ = 0.25f * searchPeak_ + 0.75f * signalPeak_;
+                acceptBeat(searchIndex_, searchPeak_);
+            }
+        }
+
+        prev_[1] = prev_[0];
+        prev_[0] = value;
+    }
+}
+
+void QrsDetector::acceptBeat(std::uint64_t index, float peak) {
+    (void)peak;
+    if (beats_ > 0) {
+        rr_[rrCount_ % RR_HISTORY] = static_cast<double>(index - lastBeat_);
+        ++rrCount_;
+    }
+    lastBeat_ = index;
+    ++beats_;
+    searchPeak_ = 0.0f;
+}
+
+double QrsDetector::bpm() const {
+    if (rrCount_ == 0)
+        return 0.0;
+    int n = std::min(rrCount_, static_cast<int>(RR_HISTORY));
+    double sum = 0.0;
+    for (int r = 0; r < n; ++r) sum += rr_[r];
+    return 60.0 * sampleRate_ * n / sum;
+}
+
+double QrsDetector::lastBeatTime() const {
+    return (static_cast<double>(lastBeat_) - delay_) / sampleRate_;
+}
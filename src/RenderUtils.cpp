@@ -15,6 +15,39 @@ void preprocessTexture(unsigned& texture, const char* filepath) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 }
 
+bool createRenderTarget(RenderTarget& target, int width, int height) {
+    target.width = width;
+    target.height = height;
+
+    glGenTextures(1, &target.texture);
+    glBindTexture(GL_TEXTURE_2D, target.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint previous = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous);
+
+    glGenFramebuffers(1, &target.fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, target.fbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, target.texture, 0);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previous));
+
+    if (!complete)
+        destroyRenderTarget(target);
+    return complete;
+}
+
+void destroyRenderTarget(RenderTarget& target) {
+    if (target.fbo) glDeleteFramebuffers(1, &target.fbo);
+    if (target.texture) glDeleteTextures(1, &target.texture);
+    target = RenderTarget();
+}
+
 void formQuadVAO(unsigned int& outVAO, unsigned int& outVBO) {
     float vertices[] = {
         // pos         // uv
@@ -42,52 +75,39 @@ void formQuadVAO(unsigned int& outVAO, unsigned int& outVBO) {
     glBindVertexArray(0);
 }
 
-void drawElement(unsigned int shader, unsigned int VAO_local, unsigned int texture,
-                 float x, float y, float w, float h,
-                 float uvX, float uvY, float uvW, float uvH,
-                 float r, float g, float b, float a)
-{
-    glUseProgram(shader);
-
-    if (texture != 0) {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, texture);
-        GLint texLoc = glGetUniformLocation(shader, "u_image");
-        if (texLoc >= 0)
-            glUniform1i(texLoc, 0);
-    } else {
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, 0);
+QuadShader makeQuadShader(const ShaderProgram& program) {
+    QuadShader shader;
+    shader.program      = program;
+    shader.pos          = program.uniform<UniformVec2>("uPos");
+    shader.scale        = program.uniform<UniformVec2>("uScale");
+    shader.uvTransform  = program.uniform<UniformVec4>("u_uvTransform");
+    shader.color        = program.uniform<UniformVec4>("u_colorObj");
+    shader.fillLevel    = program.uniform<UniformFloat>("u_fillLevel");
+    shader.image        = program.uniform<UniformSampler>("u_image");
+
+    // Sampler uvek cita jedinicu 0 - postavlja se jednom, ne pri svakom crtanju
+    if (program.valid() && shader.image.valid()) {
+        program.use();
+        shader.image.set(0);
     }
-
-    GLint posLoc = glGetUniformLocation(shader, "uPos");
-    GLint scaleLoc = glGetUniformLocation(shader, "uScale");
-    GLint uvLoc = glGetUniformLocation(shader, "u_uvTransform");
-    GLint colLoc = glGetUniformLocation(shader, "u_colorObj");
-
-    if (posLoc >= 0)   glUniform2f(posLoc, x, y);
-    if (scaleLoc >= 0) glUniform2f(scaleLoc, w, h);
-    if (uvLoc >= 0)    glUniform4f(uvLoc, uvX, uvY, uvW, uvH);
-    if (colLoc >= 0)   glUniform4f(colLoc, r, g, b, a);
-
-    glBindVertexArray(VAO_local);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
+    return shader;
 }
 
-void drawBatteryQuad(unsigned int shader, unsigned int VAO_local,
+void drawBatteryQuad(QuadShaders& shaders, unsigned int VAO_local,
                      float x, float y, float w, float h, float level)
 {
-    glUseProgram(shader);
-
-    GLint posLoc   = glGetUniformLocation(shader, "uPos");
-    GLint scaleLoc = glGetUniformLocation(shader, "uScale");
-    GLint levelLoc = glGetUniformLocation(shader, "u_batteryLevel");
-    GLint uvLoc    = glGetUniformLocation(shader, "u_uvTransform");
-
-    if (posLoc >= 0)   glUniform2f(posLoc, x, y);
-    if (scaleLoc >= 0) glUniform2f(scaleLoc, w, h);
-    if (levelLoc >= 0) glUniform1f(levelLoc, level);
-    if (uvLoc >= 0)    glUniform4f(uvLoc, 0.0f, 0.0f, 1.0f, 1.0f);
+    const QuadShader& shader = shaders.get(SHADER_FILL | SHADER_TINT);
+    shader.program.use();
+
+    // Crvena (< 10%), zuta (< 20%), zelena (100% - 20%)
+    if (level <= 0.1f)      shader.color.set(1.0f, 0.0f, 0.0f, 1.0f);
+    else if (level <= 0.2f) shader.color.set(1.0f, 1.0f, 0.0f, 1.0f);
+    else                    shader.color.set(0.0f, 1.0f, 0.0f, 1.0f);
+
+    shader.pos.set(x, y);
+    shader.scale.set(w, h);
+    shader.fillLevel.set(level);
+    shader.uvTransform.set(0.0f, 0.0f, 1.0f, 1.0f);
 
     glBindVertexArray(VAO_local);
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
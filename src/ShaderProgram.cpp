@@ -0,0 +1,96 @@
+#include "ShaderProgram.hpp"
+
+#include <iostream>
+
+static bool isSamplerType(GLenum type) {
+    switch (type) {
+    case GL_SAMPLER_1D:
+    case GL_SAMPLER_2D:
+    case GL_SAMPLER_3D:
+    case GL_SAMPLER_CUBE:
+    case GL_SAMPLER_2D_ARRAY:
+        return true;
+    default:
+        return false;
+    }
+}
+
+ShaderProgram::ShaderProgram()
+    : id_(0)
+{
+}
+
+ShaderProgram ShaderProgram::fromLinked(GLuint program) {
+    ShaderProgram result;
+    result.id_ = program;
+    if (program == 0)
+        return result;
+
+    GLint count = 0;
+    GLint maxLength = 0;
+    std::vector<char> name;
+
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    name.resize(maxLength > 0 ? maxLength : 1);
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        Variable v;
+        glGetActiveUniform(program, static_cast<GLuint>(i), static_cast<GLsizei>(name.size()),
+                           &length, &v.size, &v.type, name.data());
+        v.name.assign(name.data(), length);
+        // Nizovi se prijavljuju kao "ime[0]"
+        std::string::size_type bracket = v.name.find('[');
+        if (bracket != std::string::npos) v.name.resize(bracket);
+        v.location = glGetUniformLocation(program, v.name.c_str());
+        result.uniforms_.push_back(v);
+    }
+
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &count);
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+    name.resize(maxLength > 0 ? maxLength : 1);
+    for (GLint i = 0; i < count; ++i) {
+        GLsizei length = 0;
+        Variable v;
+        glGetActiveAttrib(program, static_cast<GLuint>(i), static_cast<GLsizei>(name.size()),
+                          &length, &v.size, &v.type, name.data());
+        v.name.assign(name.data(), length);
+        v.location = glGetAttribLocation(program, v.name.c_str());
+        result.attributes_.push_back(v);
+    }
+
+    return result;
+}
+
+void ShaderProgram::destroy() {
+    if (id_) glDeleteProgram(id_);
+    id_ = 0;
+    uniforms_.clear();
+    attributes_.clear();
+}
+
+GLint ShaderProgram::findUniform(const char* name, GLenum expectedType) const {
+    for (const Variable& v : uniforms_) {
+        if (v.name != name)
+            continue;
+
+        bool typeOk = (v.type == expectedType) ||
+                      (isSamplerType(v.type) && isSamplerType(expectedType));
+        if (!typeOk) {
+            std::cout << "Uniform \"" << name << "\" ima drugaciji tip u shaderu (0x"
+                      << std::hex << v.type << ", ocekivano 0x" << expectedType << std::dec << ")!" << std::endl;
+            return -1;
+        }
+        return v.location;
+    }
+    // Neaktivan uniform (optimizovan od strane kompajlera) nije greska - handle ostaje nevazeci
+    return -1;
+}
+
+GLint ShaderProgram::attribute(const char* name) const {
+    for (const Variable& v : attributes_) {
+        if (v.name == name)
+            return v.location;
+    }
+    return -1;
+}
@@ -0,0 +1,20 @@
+#include "ShaderVariants.hpp"
+#include "Util.hpp"
+
+std::string shaderFeatureDefines(unsigned features) {
+    static const char* const names[SHADER_FEATURE_BITS] = { "TEXTURED", "ALPHA_TEST", "TINT", "FILL" };
+
+    std::string defines;
+    for (int bit = 0; bit < SHADER_FEATURE_BITS; ++bit) {
+        if (features & (1u << bit)) {
+            defines += "#define ";
+            defines += names[bit];
+            defines += "\n";
+        }
+    }
+    return defines;
+}
+
+ShaderProgram createShaderVariant(const char* vsSource, const char* fsSource, unsigned features) {
+    return createShader(vsSource, fsSource, shaderFeatureDefines(features).c_str());
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "SimulationThread.hpp"
+
+#include <chrono>
+
+void WatchSnapshot::interpolate(double time, WatchState& outState) const {
+    double alpha = (time - current.time) / stepTime;
+    if (alpha < 0.0) alpha = 0.0;
+    if (alpha > 1.0) alpha = 1.0;
+    interpolateState(previous, current, alpha, outState);
+}
+
+SimulationThread::SimulationThread()
+    : running_(false),
+      stop_(false),
+      clock_(nullptr)
+{
+}
+
+SimulationThread::~SimulationThread() {
+    destroy();
+}
+
+void SimulationThread::init(double startTime, double rate, unsigned seed) {
+    destroy();
+    sim_.init(startTime, rate, seed);
+    publish();
+    buffer_.update();
+}
+
+void SimulationThread::start(double (*clock)()) {
+    if (threaded())
+        return;
+    clock_ = clock;
+    stop_.store(false, std::memory_order_relaxed);
+    thread_ = std::thread(&SimulationThread::threadLoop, this);
+}
+
+void SimulationThread::destroy() {
+    if (!threaded())
+        return;
+    stop_.store(true, std::memory_order_release);
+    thread_.join();
+}
+
+void SimulationThread::advance(double currentTime) {
+    sim_.setRunning(running_.load(std::memory_order_relaxed));
+    if (sim_.advance(currentTime) > 0)
+        publish();
+}
+
+void SimulationThread::publish() {
+    WatchSnapshot& snapshot = buffer_.writeBuffer();
+    snapshot.previous = sim_.previous();
+    snapshot.current = sim_.current();
+    snapshot.stepTime = sim_.stepTime();
+    buffer_.publish();
+}
+
+void SimulationThread::threadLoop() {
+    while (!stop_.load(std::memory_order_acquire)) {
+        advance(clock_());
+
+        // Spava do sledeceg koraka; zaustavljanje tako kasni najvise jedan korak
+        double wait = sim_.nextStepTime() - clock_();
+        if (wait > 0.0)
+            std::this_thread::sleep_for(std::chrono::duration<double>(wait));
+    }
+}
\ No newline at end of file
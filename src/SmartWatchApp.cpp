@@ -2,38 +2,65 @@
 #include "RenderUtils.hpp"
 #include "Util.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <iostream>
 
+// Slojevi za SpriteBatch - quad-ovi se unutar sloja sortiraju po teksturi
+static const int LAYER_CONTENT = 0;
+static const int LAYER_CURSOR  = 1;
+static const int LAYER_OVERLAY = 2;
+
+// Sta treba ponovo iscrtati: scena (sadrzaj ekrana, kesira se u FBO) i/ili kompozicija (kursor i overlay)
+static const unsigned DIRTY_SCENE     = 1u << 0;
+static const unsigned DIRTY_COMPOSITE = 1u << 1;
+
+// Prioritet ucitavanja: atlas i cifre trebaju vec prvom frejmu, pa init ceka sve teksture
+static const int LOAD_FIRST_FRAME = 0;
+
+// Najduze mirovanje kada nista nije zakazano - budi samo dogadjaj (ulaz ili otkucaj sata)
+static const double IDLE_MAX = 3600.0;
+
+// EKG trag: sekundi na celoj sirini i opseg napona od donje do gornje ivice (mV)
+static const double TRACE_WINDOW = 3.0;
+static const float TRACE_MIN_MV = -0.6f;
+static const float TRACE_MAX_MV = 1.4f;
+
 SmartWatchApp::SmartWatchApp()
     : window_(nullptr),
       screenWidth_(800),
       screenHeight_(800),
       currentState_(AppState::Clock),
-      timeHH_(23), timeMM_(59), timeSS_(55),
-      lastTimeSecond_(0.0),
-      bpm_(70.0f),
-      ekgOffset_(0.0f),
+      simRate_(WatchSimulation::DEFAULT_RATE),
+      seed_(0),
+      startTime_(-1.0),
+      deterministic_(false),
+      ecgSource_(nullptr),
+      clockEpoch_(WallClock::DEFAULT_EPOCH),
+      shownSecond_(-1),
       isRunning_(false),
-      lastFrameTime_(0.0),
-      lastRandomChange_(0.0),
-      rng_(static_cast<unsigned>(std::chrono::high_resolution_clock::now().time_since_epoch().count())),
-      randBpm_(60.0f, 80.0f),
-      bpmTargetRandom_(70.0f),
-      batteryLevel_(1.0f),
-      batteryTimer_(0.0f),
       mouseX_(0.0),
       mouseY_(0.0),
-      squeezeScale_(1.0f),
-      basicShader_(0),
-      batteryShader_(0),
       VAO_(0),
       VBO_(0),
-      texArrowLeft_(0), texArrowRight_(0), texHeart_(0), texEKG_(0), texBatteryFrame_(0),
-      texColon_(0), texPercent_(0), texIDOverlay_(0), texWarningFull_(0)
+      dirty_(DIRTY_SCENE | DIRTY_COMPOSITE),
+      warningShown_(false),
+      internalWidth_(0),
+      internalHeight_(0),
+      upscaleFilter_(GL_LINEAR),
+      presentX0_(0.0f), presentY0_(0.0f), presentX1_(1.0f), presentY1_(1.0f)
 {
-    for (int i = 0; i < 10; ++i) texNumbers_[i] = 0;
+}
+
+SmartWatchApp::~SmartWatchApp() {
+    shutdown();
+}
+
+void SmartWatchApp::setInternalResolution(int width, int height, GLenum filter) {
+    internalWidth_ = width;
+    internalHeight_ = height;
+    upscaleFilter_ = filter;
 }
 
 bool SmartWatchApp::init(GLFWwindow* window, int screenWidth, int screenHeight) {
@@ -41,115 +68,248 @@ bool SmartWatchApp::init(GLFWwindow* window, int screenWidth, int screenHeight)
     screenWidth_ = screenWidth;
     screenHeight_ = screenHeight;
 
-    glfwSetInputMode(window_, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
+    // Bez prozora (headless) nema GLFW-a - vreme i kursor zadaje pozivalac
+    if (window_)
+        glfwSetInputMode(window_, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
 
-    basicShader_   = createShader("shaders/basic.vert",  "shaders/basic.frag");
-    batteryShader_ = createShader("shaders/basic.vert",  "shaders/battery.frag");
+    quadShaders_.init("shaders/basic.vert", "shaders/quad.frag", makeQuadShader);
+    spriteShaders_.init("shaders/sprite.vert", "shaders/sprite.frag", makeProgram);
+    digitsShader_ = createShader("shaders/digits.vert", "shaders/sdf.frag");
+    traceShader_ = createShader("shaders/trace.vert", "shaders/trace.frag");
 
-    if (!basicShader_ || !batteryShader_) {
+    if (!digitsShader_ || !traceShader_) {
         std::cerr << "Greska pri ucitavanju shadera!\n";
         return false;
     }
 
     formQuadVAO(VAO_, VBO_);
 
-    preprocessTexture(texArrowLeft_,  "res/arrow_left.png");
-    preprocessTexture(texArrowRight_, "res/arrow_right.png");
-    preprocessTexture(texHeart_,      "res/heart.png");
-    preprocessTexture(texEKG_,        "res/ekg.png");
-    preprocessTexture(texBatteryFrame_, "res/battery_frame.png");
-    preprocessTexture(texColon_,      "res/colon.png");
-    preprocessTexture(texPercent_,    "res/percent.png");
-    preprocessTexture(texIDOverlay_,  "res/id_overlay.png");
-    preprocessTexture(texWarningFull_,"res/warning_full.png");
-
-    for (int i = 0; i < 10; ++i) {
-        std::string p = "res/" + std::to_string(i) + ".png";
-        preprocessTexture(texNumbers_[i], p.c_str());
+    if (!batch_.init(spriteShaders_)) {
+        std::cerr << "Greska pri pravljenju sprite batch-a!\n";
+        return false;
+    }
+
+    // Sve slike se dekodiraju paralelno; ceka se samo na ono sto je potrebno za prvi frejm
+    atlas_.load(loader_, LOAD_FIRST_FRAME);
+    if (!digits_.init(digitsShader_, loader_, LOAD_FIRST_FRAME)) {
+        std::cerr << "Greska pri ucitavanju cifara!\n";
+        return false;
+    }
+
+    if (!trace_.init(traceShader_)) {
+        std::cerr << "Greska pri pravljenju EKG traga!\n";
+        return false;
+    }
+
+    loader_.start();
+    if (!loader_.waitFor(LOAD_FIRST_FRAME)) {
+        std::cerr << "Greska pri ucitavanju tekstura!\n";
+        return false;
     }
 
-    double t = glfwGetTime();
-    lastFrameTime_   = t;
-    lastTimeSecond_  = t;
-    lastRandomChange_ = t;
-    bpmTargetRandom_ = randBpm_(rng_);
+    // Scena se kesira u teksturi interne rezolucije, odnosno velicine framebuffer-a
+    // (viewport je vec postavljen na njega)
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    bool internal = internalWidth_ > 0 && internalHeight_ > 0;
+    int sceneWidth  = internal ? internalWidth_  : viewport[2];
+    int sceneHeight = internal ? internalHeight_ : viewport[3];
+
+    if (!createRenderTarget(sceneTarget_, sceneWidth, sceneHeight) ||
+        (internal && !createRenderTarget(frameTarget_, sceneWidth, sceneHeight))) {
+        std::cerr << "Greska pri pravljenju FBO-a za scenu!\n";
+        return false;
+    }
+
+    if (internal) {
+        // Najveci pravougaonik istog odnosa stranica koji staje u izlaz, centriran
+        float scale = std::min(static_cast<float>(viewport[2]) / sceneWidth,
+                               static_cast<float>(viewport[3]) / sceneHeight);
+        float fracW = sceneWidth  * scale / viewport[2];
+        float fracH = sceneHeight * scale / viewport[3];
+        presentX0_ = 0.5f - fracW * 0.5f;
+        presentX1_ = 0.5f + fracW * 0.5f;
+        presentY0_ = 0.5f - fracH * 0.5f;
+        presentY1_ = 0.5f + fracH * 0.5f;
+    }
+
+    double t = startTime_ >= 0.0 ? startTime_ : (window_ ? glfwGetTime() : 0.0);
+    startTime_ = t;
+    simulation_.init(t, simRate_, seed_);
+    simulation_.latest().interpolate(t, view_);
+
+    if (ecgSource_) {
+        if (!ecgReader_.start(ecgSource_, ecgRing_))
+            return false;
+        simulation_.setEcgInput(&ecgRing_);
+    }
+    simulation_.setEcgOutput(&traceRing_);
+
+    clock_.init(clockEpoch_, t);
+    shownSecond_ = clock_.secondOfDay(t);
+    timeOfDay_ = TimeOfDay::fromSecond(shownSecond_);
+
+    // Headless i deterministicki rezim koracaju vreme iz update(), pa tamo niti ne postoje
+    if (window_ && !deterministic_) {
+        simulation_.start(glfwGetTime);
+        // Otkucaj budi petlju iz glfwWaitEventsTimeout tacno na granici sekunde
+        clock_.startTicker(glfwGetTime, glfwPostEmptyEvent);
+    }
 
     return true;
 }
 
+void SmartWatchApp::shutdown() {
+    clock_.stopTicker();
+    // Nit simulacije prazni ecgRing_ i puni traceRing_, pa staje pre citaca; prstenovi se
+    // unistavaju tek posle
+    simulation_.destroy();
+    ecgReader_.stop();
+}
+
 void SmartWatchApp::update(double currentTime) {
+    // Simulacija sustize vreme u fiksnim koracima; koliko god retko da se crta, rezultat je isti.
+    // Sa niti se samo uzima najnoviji snimak - render nikad ne ceka simulaciju.
+    simulation_.setRunning(isRunning_);
+    if (!simulation_.threaded())
+        simulation_.advance(currentTime);
+
+    // Novi uzorci traga idu na GPU odmah, i kada ekran srca nije prikazan
+    EcgSample block[256];
+    std::size_t count;
+    while ((count = traceRing_.pop(block, 256)) > 0)
+        trace_.append(block, count);
+
+    WatchState next;
+    simulation_.latest().interpolate(currentTime, next);
+    markChanges(view_, next);
+    view_ = next;
+
+    int second = clockSecond(currentTime);
+    if (second != shownSecond_) {
+        shownSecond_ = second;
+        timeOfDay_ = TimeOfDay::fromSecond(second);
+        if (currentState_ == AppState::Clock)
+            dirty_ |= DIRTY_SCENE;
+    }
+}
 
-    double deltaTime = currentTime - lastFrameTime_;
-    lastFrameTime_ = currentTime;
-    if (deltaTime < 0.0) deltaTime = 0.0;
+int SmartWatchApp::clockSecond(double currentTime) const {
+    return clock_.ticking() ? clock_.tickedSecond() : clock_.secondOfDay(currentTime);
+}
 
-    glfwGetCursorPos(window_, &mouseX_, &mouseY_);
+void SmartWatchApp::markChanges(const WatchState& previous, const WatchState& next) {
+    if (next.squeezeScale != previous.squeezeScale)
+        dirty_ |= DIRTY_COMPOSITE;
 
-    const float speed = 0.2f; // promena po sekundi
-    if (isRunning_) {
-        squeezeScale_ -= speed * static_cast<float>(deltaTime);
-        if (squeezeScale_ < 0.2f) squeezeScale_ = 0.2f;
-    } else {
-        squeezeScale_ += speed * static_cast<float>(deltaTime);
-        if (squeezeScale_ > 1.0f) squeezeScale_ = 1.0f;
+    if (currentState_ == AppState::Battery && next.batteryLevel != previous.batteryLevel)
+        dirty_ |= DIRTY_SCENE;
+
+    // Upozorenje se pali/gasi preko bilo kog ekrana, a ekran srca se tada prazni
+    bool warning = next.warning();
+    if (warning != warningShown_) {
+        warningShown_ = warning;
+        dirty_ |= DIRTY_SCENE | DIRTY_COMPOSITE;
     }
 
-    updateTimeAndBattery(currentTime);
-    updateBpmAndEkg(currentTime, deltaTime);
+    // EKG trag se pomera sa vremenom
+    if (currentState_ == AppState::Heart && !warning &&
+        (next.time != previous.time || next.bpm != previous.bpm))
+        dirty_ |= DIRTY_SCENE;
+}
 
-    // EKG offset - pomera teksturu
-    ekgOffset_ += (bpm_ / 100.0f) * static_cast<float>(deltaTime);
+double SmartWatchApp::idleTimeout(double currentTime) const {
+    if (dirty_ != 0)
+        return 0.0;
+
+    // EKG se pomera, sat se steze/opusta, ili BPM ide ka granici upozorenja
+    bool ekgScrolling = currentState_ == AppState::Heart && !warningShown_;
+    bool squeezing = isRunning_ ? view_.squeezeScale > 0.2f : view_.squeezeScale < 1.0f;
+    bool bpmCrossing = isRunning_ != warningShown_;
+    if (ekgScrolling || squeezing || bpmCrossing)
+        return 0.0;
+
+    // Inace je sledeca promena otkucaj sata (ako ga ticker ne javlja sam) ili pad baterije
+    double timeout = IDLE_MAX;
+    if (currentState_ == AppState::Clock && !clock_.ticking())
+        timeout = clock_.untilNextSecond(currentTime);
+    if (currentState_ == AppState::Battery && view_.batteryLevel > 0.0f)
+        timeout = view_.nextBatteryDrop - currentTime;
+    return timeout > 0.0 ? timeout : 0.0;
 }
 
-void SmartWatchApp::updateTimeAndBattery(double currentTime) {
-    if (currentTime - lastTimeSecond_ >= 1.0) {
-        timeSS_++;
-        if (timeSS_ >= 60) {
-            timeSS_ = 0;
-            timeMM_++;
-            if (timeMM_ >= 60) {
-                timeMM_ = 0;
-                timeHH_++;
-                if (timeHH_ >= 24) timeHH_ = 0;
-            }
-        }
+bool SmartWatchApp::render() {
+    if (dirty_ == 0)
+        return false;
+
+    // Izlaz je ono sto je vezano pri pozivu (podrazumevani framebuffer prozora ili FBO pozivaoca)
+    GLint output = 0;
+    GLint viewport[4];
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &output);
+    glGetIntegerv(GL_VIEWPORT, viewport);
 
-        batteryTimer_ += 1.0f;
-        if (batteryTimer_ >= 10.0f) {
-            batteryLevel_ -= 0.01f;
-            if (batteryLevel_ < 0.0f) batteryLevel_ = 0.0f;
-            batteryTimer_ = 0.0f;
+    // Sa internom rezolucijom kompozicija ide u frameTarget_, koji se na kraju razvlaci na izlaz
+    GLuint composite = frameTarget_.fbo ? frameTarget_.fbo : static_cast<GLuint>(output);
+    glViewport(0, 0, sceneTarget_.width, sceneTarget_.height);
+
+    if (dirty_ & DIRTY_SCENE) {
+        glBindFramebuffer(GL_FRAMEBUFFER, sceneTarget_.fbo);
+
+        glClearColor(0.8f, 0.8f, 0.8f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+
+        batch_.begin();
+        batch_.setLayer(LAYER_CONTENT);
+
+        switch (currentState_) {
+            case AppState::Clock:   renderClockScreen();  break;
+            case AppState::Heart:   renderHeartScreen();  break;
+            case AppState::Battery: renderBatteryScreen(); break;
         }
 
-        lastTimeSecond_ = currentTime;
+        // Sadrzaj ekrana, pa svi brojevi jednim instanciranim pozivom
+        batch_.flush();
+        digits_.flush();
     }
-}
 
-void SmartWatchApp::updateBpmAndEkg(double currentTime, double deltaTime) {
-    if (isRunning_) {
-        float target = 220.0f;
-        bpm_ += (target - bpm_) * static_cast<float>(deltaTime) * 0.5f;
-    } else {
-        if (currentTime - lastRandomChange_ >= 0.5) {
-            bpmTargetRandom_ = randBpm_(rng_);
-            lastRandomChange_ = currentTime;
+    // Kompozicija: kesirana scena, pa kursor i overlay preko nje
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, sceneTarget_.fbo);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, composite);
+    glBlitFramebuffer(0, 0, sceneTarget_.width, sceneTarget_.height,
+                      0, 0, sceneTarget_.width, sceneTarget_.height,
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, composite);
+
+    batch_.begin();
+    renderCursorAndOverlay();
+    renderWarningOverlay();
+    batch_.flush();
+
+    if (frameTarget_.fbo) {
+        // Jedini prolaz u punoj rezoluciji izlaza; trake sa strane se brisu samo ako postoje
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(output));
+        if (presentX0_ > 0.0f || presentY0_ > 0.0f) {
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
         }
-        bpm_ += (bpmTargetRandom_ - bpm_) * static_cast<float>(deltaTime * 1.5);
-    }
-}
 
-void SmartWatchApp::render() {
-    glClearColor(0.8f, 0.8f, 0.8f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
+        int dstX0 = viewport[0] + static_cast<int>(std::lround(presentX0_ * viewport[2]));
+        int dstX1 = viewport[0] + static_cast<int>(std::lround(presentX1_ * viewport[2]));
+        int dstY0 = viewport[1] + static_cast<int>(std::lround(presentY0_ * viewport[3]));
+        int dstY1 = viewport[1] + static_cast<int>(std::lround(presentY1_ * viewport[3]));
 
-    switch (currentState_) {
-        case AppState::Clock:   renderClockScreen();  break;
-        case AppState::Heart:   renderHeartScreen();  break;
-        case AppState::Battery: renderBatteryScreen(); break;
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, frameTarget_.fbo);
+        glBlitFramebuffer(0, 0, frameTarget_.width, frameTarget_.height,
+                          dstX0, dstY0, dstX1, dstY1,
+                          GL_COLOR_BUFFER_BIT, upscaleFilter_);
     }
 
-    renderCursorAndOverlay();
-    renderWarningOverlay();
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(output));
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+    dirty_ = 0;
+    return true;
 }
 
 void SmartWatchApp::renderClockScreen() {
@@ -157,90 +317,91 @@ void SmartWatchApp::renderClockScreen() {
     float numH = 0.15f;
     float startX = -0.4f;
 
+    float spacing = 0.15f;
+
     // HH
-    drawElement(basicShader_, VAO_, texNumbers_[timeHH_ / 10], startX, 0.0f, numW, numH);
-    drawElement(basicShader_, VAO_, texNumbers_[timeHH_ % 10], startX + 0.15f, 0.0f, numW, numH);
+    digits_.drawNumber(timeOfDay_.hh, startX, 0.0f, numW, spacing, numH, 2);
 
-    drawElement(basicShader_, VAO_, texColon_, startX + 0.28f, 0.0f, numW, numH);
+    digits_.drawGlyph(Glyph::Colon, startX + 0.28f, 0.0f, numW, numH);
 
     // MM
-    drawElement(basicShader_, VAO_, texNumbers_[timeMM_ / 10], startX + 0.4f, 0.0f, numW, numH);
-    drawElement(basicShader_, VAO_, texNumbers_[timeMM_ % 10], startX + 0.55f, 0.0f, numW, numH);
+    digits_.drawNumber(timeOfDay_.mm, startX + 0.4f, 0.0f, numW, spacing, numH, 2);
 
-    drawElement(basicShader_, VAO_, texColon_, startX + 0.68f, 0.0f, numW, numH);
+    digits_.drawGlyph(Glyph::Colon, startX + 0.68f, 0.0f, numW, numH);
 
     // SS
-    drawElement(basicShader_, VAO_, texNumbers_[timeSS_ / 10], startX + 0.8f, 0.0f, numW, numH);
-    drawElement(basicShader_, VAO_, texNumbers_[timeSS_ % 10], startX + 0.95f, 0.0f, numW, numH);
+    digits_.drawNumber(timeOfDay_.ss, startX + 0.8f, 0.0f, numW, spacing, numH, 2);
 
-    drawElement(basicShader_, VAO_, texArrowRight_, 0.85f, 0.0f, 0.08f, 0.1f);
+    drawSprite(SpriteId::ArrowRight, 0.85f, 0.0f, 0.08f, 0.1f);
 }
 
 void SmartWatchApp::renderHeartScreen() {
-    if (bpm_ > 200.0f) {
+    if (view_.warning()) {
         return;
     }
 
     float r = 1.0f, g = 1.0f, b = 1.0f;
 
-    drawElement(basicShader_, VAO_, texArrowLeft_,  -0.85f, 0.0f, 0.08f, 0.08f, 0,0,1,1, r,g,b,1.0f);
-    drawElement(basicShader_, VAO_, texArrowRight_,  0.85f, 0.0f, 0.08f, 0.08f, 0,0,1,1, r,g,b,1.0f);
+    drawSprite(SpriteId::ArrowLeft,  -0.85f, 0.0f, 0.08f, 0.08f, r,g,b,1.0f);
+    drawSprite(SpriteId::ArrowRight,  0.85f, 0.0f, 0.08f, 0.08f, r,g,b,1.0f);
 
-    // EKG
-    float ekgScale = 1.0f + (bpm_ / 100.0f);
-    drawElement(basicShader_, VAO_, texEKG_, 0.0f, 0.0f, 0.7f * squeezeScale_, 0.4f,
-                ekgOffset_, 0.0f, ekgScale, 1.0f, r,g,b,1.0f);
+    // EKG trag - poslednjih TRACE_WINDOW sekundi uzoraka, desna ivica je vreme prikaza.
+    // Crta se mimo batch-a, pa strelice idu pre njega; bez uzoraka u prozoru batch ostaje ceo.
+    if (trace_.visible(view_.time, TRACE_WINDOW)) {
+        batch_.flush();
+        trace_.draw(view_.time, TRACE_WINDOW, 0.0f, 0.0f, 0.7f * view_.squeezeScale, 0.4f,
+                    TRACE_MIN_MV, TRACE_MAX_MV, sceneTarget_.width, sceneTarget_.height,
+                    0.1f * r, 0.1f * g, 0.1f * b, 1.0f);
+    }
 
-    int displayBPM = static_cast<int>(std::round(bpm_));
-    int hundreds = displayBPM / 100;
-    int tens     = (displayBPM / 10) % 10;
-    int ones     = displayBPM % 10;
+    int displayBPM = static_cast<int>(std::round(view_.bpm));
 
-    float numW = 0.07f, numH = 0.1f;
+    float numW = 0.07f, numH = 0.1f, spacing = 0.12f;
     float baseX = -0.15f, baseY = 0.45f;
 
-    if (hundreds > 0) {
-        drawElement(basicShader_, VAO_, texNumbers_[hundreds], baseX, baseY, numW, numH);
-        drawElement(basicShader_, VAO_, texNumbers_[tens],     baseX + 0.12f, baseY, numW, numH);
-        drawElement(basicShader_, VAO_, texNumbers_[ones],     baseX + 0.24f, baseY, numW, numH);
-    } else {
-        drawElement(basicShader_, VAO_, texNumbers_[tens], baseX + 0.12f, baseY, numW, numH);
-        drawElement(basicShader_, VAO_, texNumbers_[ones], baseX + 0.24f, baseY, numW, numH);
-    }
+    // Poravnato udesno - bez stotina broj pocinje od mesta desetica
+    float firstX = (displayBPM >= 100) ? baseX : baseX + spacing;
+    digits_.drawNumber(displayBPM, firstX, baseY, numW, spacing, numH, 2);
 }
 
 void SmartWatchApp::renderBatteryScreen() {
-    drawElement(basicShader_, VAO_, texArrowLeft_, -0.85f, 0.0f, 0.08f, 0.08f);
+    drawSprite(SpriteId::ArrowLeft, -0.85f, 0.0f, 0.08f, 0.08f);
 
-    drawElement(basicShader_, VAO_, texBatteryFrame_, 0.0f, 0.0f, 0.5f, 0.40f);
-    drawBatteryQuad(batteryShader_, VAO_, 0.025f, 0.0f, 0.40f, 0.15f, batteryLevel_);
+    drawSprite(SpriteId::BatteryFrame, 0.0f, 0.0f, 0.5f, 0.40f);
 
-    int percent = static_cast<int>(std::round(batteryLevel_ * 100.0f));
+    // Punjenje ide preko okvira i koristi poseban shader, pa okvir mora biti iscrtan pre njega
+    batch_.flush();
+    drawBatteryQuad(quadShaders_, VAO_, 0.025f, 0.0f, 0.40f, 0.15f, view_.batteryLevel);
+
+    int percent = static_cast<int>(std::round(view_.batteryLevel * 100.0f));
     float txtW = 0.05f, txtH = 0.08f, baseX = -0.06f, baseY = 0.35f;
 
+    float spacing = 0.10f;
+
     if (percent >= 100) {
-        drawElement(basicShader_, VAO_, texNumbers_[1], baseX - 0.06f, baseY, txtW, txtH);
-        drawElement(basicShader_, VAO_, texNumbers_[0], baseX + 0.04f, baseY, txtW, txtH);
-        drawElement(basicShader_, VAO_, texNumbers_[0], baseX + 0.14f, baseY, txtW, txtH);
-        drawElement(basicShader_, VAO_, texPercent_,    baseX + 0.26f, baseY, txtW, txtH);
+        digits_.drawNumber(percent, baseX - 0.06f, baseY, txtW, spacing, txtH);
+        digits_.drawGlyph(Glyph::Percent, baseX + 0.26f, baseY, txtW, txtH);
     } else if (percent < 10) {
         if (percent > 0) {
-            drawElement(basicShader_, VAO_, texNumbers_[percent], baseX + 0.04f, baseY, txtW, txtH);
-            drawElement(basicShader_, VAO_, texPercent_,          baseX + 0.14f, baseY, txtW, txtH);
+            digits_.drawNumber(percent, baseX + 0.04f, baseY, txtW, spacing, txtH);
+            digits_.drawGlyph(Glyph::Percent, baseX + 0.14f, baseY, txtW, txtH);
         } else {
-            drawElement(basicShader_, VAO_, texPercent_, baseX + 0.04f, baseY, txtW, txtH);
+            digits_.drawGlyph(Glyph::Percent, baseX + 0.04f, baseY, txtW, txtH);
         }
     } else {
-        drawElement(basicShader_, VAO_, texNumbers_[percent/10], baseX,       baseY, txtW, txtH);
-        drawElement(basicShader_, VAO_, texNumbers_[percent%10], baseX + 0.10f, baseY, txtW, txtH);
-        drawElement(basicShader_, VAO_, texPercent_,            baseX + 0.20f, baseY, 0.04f, 0.06f);
+        digits_.drawNumber(percent, baseX, baseY, txtW, spacing, txtH);
+        digits_.drawGlyph(Glyph::Percent, baseX + 0.20f, baseY, 0.04f, 0.06f);
     }
 }
 
 void SmartWatchApp::renderCursorAndOverlay() {
-    float mx = static_cast<float>(mouseX_) / (screenWidth_ / 2.0f) - 1.0f;
-    float my = - (static_cast<float>(mouseY_) / (screenHeight_ / 2.0f) - 1.0f);
-    drawElement(basicShader_, VAO_, texHeart_, mx, my, 0.06f * squeezeScale_, 0.06f * squeezeScale_);
+    batch_.setLayer(LAYER_CURSOR);
+
+    float mx, my;
+    windowToNdc(mouseX_, mouseY_, mx, my);
+    drawSprite(SpriteId::Heart, mx, my, 0.06f * view_.squeezeScale, 0.06f * view_.squeezeScale);
+
+    batch_.setLayer(LAYER_OVERLAY);
 
     float overlayW = 0.28f, overlayH = 0.12f;
     float overlayX = 1.0f - overlayW / 2.0f - 0.02f;
@@ -249,39 +410,59 @@ void SmartWatchApp::renderCursorAndOverlay() {
     float ox = overlayX * 2.0f - 1.0f;
     float oy = overlayY * 2.0f - 1.0f;
 
-    drawElement(basicShader_, VAO_, texIDOverlay_, ox, oy, overlayW, overlayH,
-                0,0,1,1, 1,1,1,0.6f);
+    drawSprite(SpriteId::IdOverlay, ox, oy, overlayW, overlayH, 1,1,1,0.6f);
 }
 
 void SmartWatchApp::renderWarningOverlay() {
-    if (bpm_ <= 200.0f)
+    if (!view_.warning())
         return;
 
-    if (texWarningFull_ != 0) {
-        drawElement(basicShader_, VAO_, texWarningFull_, 0.0f, 0.0f, 1.0f, 0.5f, 0,0,1,1, 1,1,1,1.0f);
-        // drawElement(basicShader_, VAO_, texWarningFull_, 0.0f, 0.0f, 2.0f, 2.0f);
+    batch_.setLayer(LAYER_OVERLAY);
+
+    if (atlas_.texture(SpriteId::WarningFull) != 0) {
+        drawSprite(SpriteId::WarningFull, 0.0f, 0.0f, 1.0f, 0.5f, 1,1,1,1.0f);
+        // drawSprite(SpriteId::WarningFull, 0.0f, 0.0f, 2.0f, 2.0f);
     } else {
-        drawElement(basicShader_, VAO_, 0, 0.0f, 0.0f, 2.0f, 2.0f, 0,0,1,1,
+        batch_.draw(0, 0.0f, 0.0f, 2.0f, 2.0f, 0,0,1,1,
                     1.0f, 0.2f, 0.2f, 0.55f);
     }
 }
 
+void SmartWatchApp::drawSprite(SpriteId id, float x, float y, float w, float h,
+                               float r, float g, float b, float a)
+{
+    batch_.draw(atlas_.texture(id), atlas_.region(id), x, y, w, h, r, g, b, a);
+}
+
 void SmartWatchApp::onKey(int key, int scancode, int action, int mods) {
     if (key == GLFW_KEY_D) {
         if (action == GLFW_PRESS)  isRunning_ = true;
         if (action == GLFW_RELEASE) isRunning_ = false;
     }
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS) {
-        glfwSetWindowShouldClose(window_, GLFW_TRUE);
+        if (window_) glfwSetWindowShouldClose(window_, GLFW_TRUE);
     }
 }
 
+void SmartWatchApp::windowToNdc(double x, double y, float& outX, float& outY) const {
+    // Prozor ima y nadole; present* su u GL smeru (y nagore)
+    float fx = static_cast<float>(x) / screenWidth_;
+    float fy = 1.0f - static_cast<float>(y) / screenHeight_;
+    outX = (fx - presentX0_) / (presentX1_ - presentX0_) * 2.0f - 1.0f;
+    outY = (fy - presentY0_) / (presentY1_ - presentY0_) * 2.0f - 1.0f;
+}
+
+void SmartWatchApp::onCursorPos(double x, double y) {
+    if (x != mouseX_ || y != mouseY_)
+        dirty_ |= DIRTY_COMPOSITE;
+    mouseX_ = x;
+    mouseY_ = y;
+}
+
 void SmartWatchApp::onMouseButton(int button, int action, int mods) {
     if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS) {
-        glfwGetCursorPos(window_, &mouseX_, &mouseY_);
-
-        float mxNorm = static_cast<float>(mouseX_) / (screenWidth_ / 2.0f) - 1.0f;
-        // float myNorm = - (static_cast<float>(mouseY_) / (screenHeight_ / 2.0f) - 1.0f);
+        float mxNorm, myNorm;
+        windowToNdc(mouseX_, mouseY_, mxNorm, myNorm);
 
         if (mxNorm > 0.7f) {
             if (currentState_ == AppState::Clock)      currentState_ = AppState::Heart;
@@ -291,5 +472,6 @@ void SmartWatchApp::onMouseButton(int button, int action, int mods) {
             if (currentState_ == AppState::Battery)    currentState_ = AppState::Heart;
             else if (currentState_ == AppState::Heart) currentState_ = AppState::Clock;
         }
+        dirty_ |= DIRTY_SCENE | DIRTY_COMPOSITE;
     }
 }
\ No newline at end of file
@@ -0,0 +1,545 @@
+#include "SoftwareRasterizer.hpp"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#if defined(__x86_64__) || defined(_M_X64) || (defined(__i386__) && defined(__SSE2__))
+#define SOFT_RASTER_SSE2 1
+#include <emmintrin.h>
+#if defined(__GNUC__) || defined(__clang__)
+#define SOFT_RASTER_AVX2 1
+#include <immintrin.h>
+#endif
+#endif
+
+bool loadSoftTexture(SoftTexture& outTexture, const char* filePath, bool repeat, bool mask) {
+    int width, height, channels;
+    unsigned char* data = stbi_load(filePath, &width, &height, &channels, mask ? 1 : 4);
+    if (!data) {
+        std::cerr << "Textura nije ucitana! Putanja texture: " << filePath << std::endl;
+        return false;
+    }
+
+    outTexture.width = width;
+    outTexture.height = height;
+    outTexture.repeat = repeat;
+    outTexture.texels.resize(static_cast<std::size_t>(width) * height);
+
+    // Isti raspored kao loadImageToTexture: prvi red je donji red slike
+    for (int y = 0; y < height; ++y) {
+        std::uint32_t* dst = &outTexture.texels[static_cast<std::size_t>(y) * width];
+        if (mask) {
+            // Isto kao swizzle (1, 1, 1, R) maske u TextureLoader-u
+            const unsigned char* src = data + static_cast<std::size_t>(height - 1 - y) * width;
+            for (int x = 0; x < width; ++x)
+                dst[x] = 0x00FFFFFFu | (static_cast<std::uint32_t>(src[x]) << 24);
+        } else {
+            const unsigned char* src = data + static_cast<std::size_t>(height - 1 - y) * width * 4;
+            std::memcpy(dst, src, static_cast<std::size_t>(width) * 4);
+        }
+    }
+    stbi_image_free(data);
+    return true;
+}
+
+namespace {
+
+// Parametri jednog reda plocice za teksturisani kernel
+struct Span {
+    std::uint32_t* dst;
+    int count;
+    const std::uint32_t* row0; // red teksture ispod i iznad tacke uzorkovanja
+    const std::uint32_t* row1;
+    float fy;
+    int texWidth;
+    bool repeat;
+    float u, du;
+    float tint[4];
+};
+
+// Alfa ispod 0.1 se odbacuje (ALPHA_TEST u quad.frag), u opsegu 0..255
+const float ALPHA_DISCARD = 0.1f * 255.0f;
+
+// Celobrojni indeksi i tezina za bilinearno uzorkovanje duz jedne ose (GL_LINEAR)
+inline void sampleAxis(float t, int size, bool repeat, int& i0, int& i1, float& f) {
+    if (repeat) t -= std::floor(t);
+    float p = t * size - 0.5f;
+    float fl = std::floor(p);
+    f = p - fl;
+    i0 = static_cast<int>(fl);
+    i1 = i0 + 1;
+    if (repeat) {
+        if (i0 < 0) i0 += size;
+        if (i1 >= size) i1 -= size;
+    } else {
+        i0 = std::min(std::max(i0, 0), size - 1);
+        i1 = std::min(std::max(i1, 0), size - 1);
+    }
+}
+
+inline float channel(std::uint32_t texel, int c) {
+    return static_cast<float>((texel >> (c * 8)) & 0xFF);
+}
+
+// Referentna implementacija jednog piksela; koriste je skalarni kernel i ostaci SIMD kernela.
+// Petlje po kanalima su pisane tako da ih kompajler moze vektorizovati i bez intrinsics-a (npr. NEON).
+inline void shadePixel(const Span& s, int i) {
+    int x0, x1;
+    float fx;
+    sampleAxis(s.u + s.du * static_cast<float>(i), s.texWidth, s.repeat, x0, x1, fx);
+
+    std::uint32_t t00 = s.row0[x0], t10 = s.row0[x1];
+    std::uint32_t t01 = s.row1[x0], t11 = s.row1[x1];
+
+    float src[4];
+    for (int c = 0; c < 4; ++c) {
+        float bottom = channel(t00, c) + (channel(t10, c) - channel(t00, c)) * fx;
+        float top    = channel(t01, c) + (channel(t11, c) - channel(t01, c)) * fx;
+        src[c] = bottom + (top - bottom) * s.fy;
+    }
+    if (src[3] < ALPHA_DISCARD)
+        return;
+
+    for (int c = 0; c < 4; ++c) src[c] *= s.tint[c];
+    float sa = src[3] * (1.0f / 255.0f);
+
+    std::uint32_t dst = s.dst[i];
+    std::uint32_t out = 0;
+    for (int c = 0; c < 4; ++c) {
+        float v = src[c] * sa + channel(dst, c) * (1.0f - sa);
+        v = std::min(std::max(v, 0.0f), 255.0f);
+        out |= static_cast<std::uint32_t>(v + 0.5f) << (c * 8);
+    }
+    s.dst[i] = out;
+}
+
+void texturedSpanScalar(const Span& s) {
+    for (int i = 0; i < s.count; ++i)
+        shadePixel(s, i);
+}
+
+#ifdef SOFT_RASTER_SSE2
+
+// SSE2 nema min/max/blend za int32 - sve preko maski
+inline __m128i selectSse(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+inline __m128 floorSse(__m128 v) {
+    __m128 t = _mm_cvtepi32_ps(_mm_cvttps_epi32(v));
+    return _mm_sub_ps(t, _mm_and_ps(_mm_cmpgt_ps(t, v), _mm_set1_ps(1.0f)));
+}
+
+inline __m128 unpackChannelSse(__m128i texels, int c) {
+    return _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(texels, c * 8), _mm_set1_epi32(0xFF)));
+}
+
+void texturedSpanSse2(const Span& s) {
+    const __m128 lane = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 size = _mm_set1_ps(static_cast<float>(s.texWidth));
+    const __m128i sizeI = _mm_set1_epi32(s.texWidth);
+    const __m128i lastI = _mm_set1_epi32(s.texWidth - 1);
+    const __m128 fy = _mm_set1_ps(s.fy);
+    const __m128 tint[4] = { _mm_set1_ps(s.tint[0]), _mm_set1_ps(s.tint[1]),
+                             _mm_set1_ps(s.tint[2]), _mm_set1_ps(s.tint[3]) };
+
+    int i = 0;
+    for (; i + 4 <= s.count; i += 4) {
+        __m128 u = _mm_add_ps(_mm_set1_ps(s.u), _mm_mul_ps(_mm_add_ps(_mm_set1_ps(static_cast<float>(i)), lane),
+                                                          _mm_set1_ps(s.du)));
+        if (s.repeat) u = _mm_sub_ps(u, floorSse(u));
+
+        __m128 p = _mm_sub_ps(_mm_mul_ps(u, size), _mm_set1_ps(0.5f));
+        __m128 fl = floorSse(p);
+        __m128 fx = _mm_sub_ps(p, fl);
+        __m128i i0 = _mm_cvttps_epi32(fl);
+        __m128i i1 = _mm_add_epi32(i0, _mm_set1_epi32(1));
+
+        if (s.repeat) {
+            i0 = _mm_add_epi32(i0, _mm_and_si128(_mm_cmplt_epi32(i0, _mm_setzero_si128()), sizeI));
+            i1 = _mm_sub_epi32(i1, _mm_and_si128(_mm_cmpgt_epi32(i1, lastI), sizeI));
+        } else {
+            i0 = _mm_andnot_si128(_mm_cmplt_epi32(i0, _mm_setzero_si128()), i0);
+            i0 = selectSse(_mm_cmpgt_epi32(i0, lastI), lastI, i0);
+            i1 = _mm_andnot_si128(_mm_cmplt_epi32(i1, _mm_setzero_si128()), i1);
+            i1 = selectSse(_mm_cmpgt_epi32(i1, lastI), lastI, i1);
+        }
+
+        // SSE2 nema gather - cetiri skalarna citanja po uglu
+        alignas(16) int a0[4], a1[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(a0), i0);
+        _mm_store_si128(reinterpret_cast<__m128i*>(a1), i1);
+        __m128i t00 = _mm_setr_epi32(s.row0[a0[0]], s.row0[a0[1]], s.row0[a0[2]], s.row0[a0[3]]);
+        __m128i t10 = _mm_setr_epi32(s.row0[a1[0]], s.row0[a1[1]], s.row0[a1[2]], s.row0[a1[3]]);
+        __m128i t01 = _mm_setr_epi32(s.row1[a0[0]], s.row1[a0[1]], s.row1[a0[2]], s.row1[a0[3]]);
+        __m128i t11 = _mm_setr_epi32(s.row1[a1[0]], s.row1[a1[1]], s.row1[a1[2]], s.row1[a1[3]]);
+
+        __m128 src[4];
+        for (int c = 0; c < 4; ++c) {
+            __m128 c00 = unpackChannelSse(t00, c), c10 = unpackChannelSse(t10, c);
+            __m128 c01 = unpackChannelSse(t01, c), c11 = unpackChannelSse(t11, c);
+            __m128 bottom = _mm_add_ps(c00, _mm_mul_ps(_mm_sub_ps(c10, c00), fx));
+            __m128 top    = _mm_add_ps(c01, _mm_mul_ps(_mm_sub_ps(c11, c01), fx));
+            src[c] = _mm_add_ps(bottom, _mm_mul_ps(_mm_sub_ps(top, bottom), fy));
+        }
+
+        __m128 keep = _mm_cmpge_ps(src[3], _mm_set1_ps(ALPHA_DISCARD));
+        if (_mm_movemask_ps(keep) == 0)
+            continue;
+
+        for (int c = 0; c < 4; ++c) src[c] = _mm_mul_ps(src[c], tint[c]);
+        __m128 sa = _mm_mul_ps(src[3], _mm_set1_ps(1.0f / 255.0f));
+        __m128 da = _mm_sub_ps(_mm_set1_ps(1.0f), sa);
+
+        __m128i dst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s.dst + i));
+        __m128i out = _mm_setzero_si128();
+        for (int c = 0; c < 4; ++c) {
+            __m128 v = _mm_add_ps(_mm_mul_ps(src[c], sa), _mm_mul_ps(unpackChannelSse(dst, c), da));
+            v = _mm_min_ps(_mm_max_ps(v, _mm_setzero_ps()), _mm_set1_ps(255.0f));
+            out = _mm_or_si128(out, _mm_slli_epi32(_mm_cvtps_epi32(v), c * 8));
+        }
+
+        out = selectSse(_mm_castps_si128(keep), out, dst);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(s.dst + i), out);
+    }
+
+    for (; i < s.count; ++i)
+        shadePixel(s, i);
+}
+
+#endif
+
+#ifdef SOFT_RASTER_AVX2
+
+__attribute__((target("avx2")))
+inline __m256 unpackChannelAvx2(__m256i texels, int c) {
+    return _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(texels, c * 8), _mm256_set1_epi32(0xFF)));
+}
+
+// Isto kao SSE2 kernel, ali 8 piksela odjednom i gather umesto skalarnih citanja
+__attribute__((target("avx2")))
+void texturedSpanAvx2(const Span& s) {
+    const __m256 lane = _mm256_setr_ps(0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f);
+    const __m256 size = _mm256_set1_ps(static_cast<float>(s.texWidth));
+    const __m256i sizeI = _mm256_set1_epi32(s.texWidth);
+    const __m256i lastI = _mm256_set1_epi32(s.texWidth - 1);
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256 fy = _mm256_set1_ps(s.fy);
+    const __m256 tint[4] = { _mm256_set1_ps(s.tint[0]), _mm256_set1_ps(s.tint[1]),
+                             _mm256_set1_ps(s.tint[2]), _mm256_set1_ps(s.tint[3]) };
+    const int* row0 = reinterpret_cast<const int*>(s.row0);
+    const int* row1 = reinterpret_cast<const int*>(s.row1);
+
+    int i = 0;
+    for (; i + 8 <= s.count; i += 8) {
+        __m256 u = _mm256_add_ps(_mm256_set1_ps(s.u),
+                                 _mm256_mul_ps(_mm256_add_ps(_mm256_set1_ps(static_cast<float>(i)), lane),
+                                               _mm256_set1_ps(s.du)));
+        if (s.repeat) u = _mm256_sub_ps(u, _mm256_floor_ps(u));
+
+        __m256 p = _mm256_sub_ps(_mm256_mul_ps(u, size), _mm256_set1_ps(0.5f));
+        __m256 fl = _mm256_floor_ps(p);
+        __m256 fx = _mm256_sub_ps(p, fl);
+        __m256i i0 = _mm256_cvttps_epi32(fl);
+        __m256i i1 = _mm256_add_epi32(i0, _mm256_set1_epi32(1));
+
+        if (s.repeat) {
+            i0 = _mm256_add_epi32(i0, _mm256_and_si256(_mm256_cmpgt_epi32(zero, i0), sizeI));
+            i1 = _mm256_sub_epi32(i1, _mm256_and_si256(_mm256_cmpgt_epi32(i1, lastI), sizeI));
+        } else {
+            i0 = _mm256_min_epi32(_mm256_max_epi32(i0, zero), lastI);
+            i1 = _mm256_min_epi32(_mm256_max_epi32(i1, zero), lastI);
+        }
+
+        __m256i t00 = _mm256_i32gather_epi32(row0, i0, 4);
+        __m256i t10 = _mm256_i32gather_epi32(row0, i1, 4);
+        __m256i t01 = _mm256_i32gather_epi32(row1, i0, 4);
+        __m256i t11 = _mm256_i32gather_epi32(row1, i1, 4);
+
+        __m256 src[4];
+        for (int c = 0; c < 4; ++c) {
+            __m256 c00 = unpackChannelAvx2(t00, c), c10 = unpackChannelAvx2(t10, c);
+            __m256 c01 = unpackChannelAvx2(t01, c), c11 = unpackChannelAvx2(t11, c);
+            __m256 bottom = _mm256_add_ps(c00, _mm256_mul_ps(_mm256_sub_ps(c10, c00), fx));
+            __m256 top    = _mm256_add_ps(c01, _mm256_mul_ps(_mm256_sub_ps(c11, c01), fx));
+            src[c] = _mm256_add_ps(bottom, _mm256_mul_ps(_mm256_sub_ps(top, bottom), fy));
+        }
+
+        __m256 keep = _mm256_cmp_ps(src[3], _mm256_set1_ps(ALPHA_DISCARD), _CMP_GE_OQ);
+        if (_mm256_movemask_ps(keep) == 0)
+            continue;
+
+        for (int c = 0; c < 4; ++c) src[c] = _mm256_mul_ps(src[c], tint[c]);
+        __m256 sa = _mm256_mul_ps(src[3], _mm256_set1_ps(1.0f / 255.0f));
+        __m256 da = _mm256_sub_ps(_mm256_set1_ps(1.0f), sa);
+
+        __m256i dst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.dst + i));
+        __m256i out = _mm256_setzero_si256();
+        for (int c = 0; c < 4; ++c) {
+            __m256 v = _mm256_add_ps(_mm256_mul_ps(src[c], sa), _mm256_mul_ps(unpackChannelAvx2(dst, c), da));
+            v = _mm256_min_ps(_mm256_max_ps(v, _mm256_setzero_ps()), _mm256_set1_ps(255.0f));
+            out = _mm256_or_si256(out, _mm256_slli_epi32(_mm256_cvtps_epi32(v), c * 8));
+        }
+
+        out = _mm256_blendv_epi8(dst, out, _mm256_castps_si256(keep));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(s.dst + i), out);
+    }
+
+    for (; i < s.count; ++i)
+        shadePixel(s, i);
+}
+
+#endif
+
+typedef void (*TexturedSpanFn)(const Span&);
+
+struct Kernel {
+    TexturedSpanFn fn;
+    const char* name;
+};
+
+// SOFT_RASTER_KERNEL=scalar|sse2|avx2 spusta izbor ispod onoga sto procesor podrzava (poredjenje kernela)
+Kernel selectKernel() {
+    const char* forced = std::getenv("SOFT_RASTER_KERNEL");
+    std::string limit = forced ? forced : "";
+
+    if (limit == "scalar")
+        return { texturedSpanScalar, "scalar" };
+#ifdef SOFT_RASTER_AVX2
+    __builtin_cpu_init();
+    if (limit != "sse2" && __builtin_cpu_supports("avx2"))
+        return { texturedSpanAvx2, "avx2" };
+#endif
+#ifdef SOFT_RASTER_SSE2
+    return { texturedSpanSse2, "sse2" };
+#else
+    return { texturedSpanScalar, "scalar" };
+#endif
+}
+
+const Kernel& kernel() {
+    static const Kernel selected = selectKernel();
+    return selected;
+}
+
+inline std::uint32_t packColor(const float rgba[4]) {
+    std::uint32_t out = 0;
+    for (int c = 0; c < 4; ++c) {
+        float v = std::min(std::max(rgba[c], 0.0f), 1.0f) * 255.0f;
+        out |= static_cast<std::uint32_t>(v + 0.5f) << (c * 8);
+    }
+    return out;
+}
+
+// Jednobojni red (netekstuirani quad, punjenje baterije); neprovidna boja se samo upisuje
+void solidSpan(std::uint32_t* dst, int count, const float rgba[4]) {
+    if (rgba[3] >= 1.0f) {
+        std::fill(dst, dst + count, packColor(rgba));
+        return;
+    }
+
+    float sa = std::max(rgba[3], 0.0f);
+    float src[4] = { rgba[0] * 255.0f * sa, rgba[1] * 255.0f * sa, rgba[2] * 255.0f * sa, rgba[3] * 255.0f * sa };
+    for (int i = 0; i < count; ++i) {
+        std::uint32_t d = dst[i];
+        std::uint32_t out = 0;
+        for (int c = 0; c < 4; ++c) {
+            float v = src[c] + channel(d, c) * (1.0f - sa);
+            out |= static_cast<std::uint32_t>(std::min(v, 255.0f) + 0.5f) << (c * 8);
+        }
+        dst[i] = out;
+    }
+}
+
+} // namespace
+
+SoftwareRasterizer::SoftwareRasterizer()
+    : width_(0),
+      height_(0),
+      tileSize_(64),
+      tilesX_(0),
+      tilesY_(0)
+{
+}
+
+bool SoftwareRasterizer::init(int width, int height, int threads, int tileSize) {
+    if (width <= 0 || height <= 0 || tileSize <= 0)
+        return false;
+
+    width_ = width;
+    height_ = height;
+    tileSize_ = tileSize;
+    tilesX_ = (width + tileSize - 1) / tileSize;
+    tilesY_ = (height + tileSize - 1) / tileSize;
+
+    color_.assign(static_cast<std::size_t>(width) * height, 0);
+    commands_.clear();
+    commands_.reserve(64);
+
+    pool_.init(threads);
+    return true;
+}
+
+void SoftwareRasterizer::destroy() {
+    pool_.destroy();
+    color_.clear();
+    commands_.clear();
+    width_ = height_ = 0;
+}
+
+const char* SoftwareRasterizer::kernelName() const {
+    return kernel().name;
+}
+
+bool SoftwareRasterizer::pixelRect(float left, float bottom, float right, float top, Command& cmd) const {
+    // Piksel pripada quad-u ako mu je centar unutra, kao kod GL rasterizacije
+    cmd.x0 = static_cast<int>(std::ceil((left   + 1.0f) * 0.5f * width_  - 0.5f));
+    cmd.x1 = static_cast<int>(std::ceil((right  + 1.0f) * 0.5f * width_  - 0.5f));
+    cmd.y0 = static_cast<int>(std::ceil((bottom + 1.0f) * 0.5f * height_ - 0.5f));
+    cmd.y1 = static_cast<int>(std::ceil((top    + 1.0f) * 0.5f * height_ - 0.5f));
+
+    cmd.x0 = std::max(cmd.x0, 0);
+    cmd.y0 = std::max(cmd.y0, 0);
+    cmd.x1 = std::min(cmd.x1, width_);
+    cmd.y1 = std::min(cmd.y1, height_);
+    return cmd.x0 < cmd.x1 && cmd.y0 < cmd.y1;
+}
+
+void SoftwareRasterizer::clear(float r, float g, float b, float a) {
+    Command cmd;
+    cmd.type = CommandType::Clear;
+    cmd.texture = nullptr;
+    cmd.x0 = cmd.y0 = 0;
+    cmd.x1 = width_;
+    cmd.y1 = height_;
+    cmd.u0 = cmd.du = cmd.v0 = cmd.dv = 0.0f;
+    cmd.color[0] = r; cmd.color[1] = g; cmd.color[2] = b; cmd.color[3] = a;
+    commands_.push_back(cmd);
+}
+
+void SoftwareRasterizer::drawQuad(const SoftTexture* texture, float x, float y, float w, float h,
+                                  float uvX, float uvY, float uvW, float uvH,
+                                  float r, float g, float b, float a)
+{
+    if (w <= 0.0f || h <= 0.0f)
+        return;
+
+    Command cmd;
+    if (!pixelRect(x - w, y - h, x + w, y + h, cmd))
+        return;
+
+    cmd.color[0] = r; cmd.color[1] = g; cmd.color[2] = b; cmd.color[3] = a;
+
+    if (!texture || texture->texels.empty()) {
+        // Bela tekstura: alfa je 1 pa nema discard-a, ostaje samo boja
+        cmd.type = CommandType::Solid;
+        cmd.texture = nullptr;
+        cmd.u0 = cmd.du = cmd.v0 = cmd.dv = 0.0f;
+        commands_.push_back(cmd);
+        return;
+    }
+
+    // Koordinata teksture u centru prvog piksela i korak po pikselu (basic.vert: uv * zw + xy)
+    float ndcX = (cmd.x0 + 0.5f) * 2.0f / width_ - 1.0f;
+    float ndcY = (cmd.y0 + 0.5f) * 2.0f / height_ - 1.0f;
+    cmd.type = CommandType::Textured;
+    cmd.texture = texture;
+    cmd.u0 = uvX + (ndcX - (x - w)) / (2.0f * w) * uvW;
+    cmd.v0 = uvY + (ndcY - (y - h)) / (2.0f * h) * uvH;
+    cmd.du = (2.0f / width_)  / (2.0f * w) * uvW;
+    cmd.dv = (2.0f / height_) / (2.0f * h) * uvH;
+    commands_.push_back(cmd);
+}
+
+void SoftwareRasterizer::drawSprite(const SoftTexture& page, const AtlasRegion& region,
+                                    float x, float y, float w, float h,
+                                    float r, float g, float b, float a)
+{
+    float cx = x + w * (region.x0 + region.x1 - 1.0f);
+    float cy = y + h * (region.y0 + region.y1 - 1.0f);
+    float cw = w * (region.x1 - region.x0);
+    float ch = h * (region.y1 - region.y0);
+
+    drawQuad(&page, cx, cy, cw, ch,
+             region.u0, region.v0, region.u1 - region.u0, region.v1 - region.v0,
+             r * region.r, g * region.g, b * region.b, a);
+}
+
+void SoftwareRasterizer::drawBatteryQuad(float x, float y, float w, float h, float level) {
+    float color[4];
+    if (level <= 0.1f)      { color[0] = 1.0f; color[1] = 0.0f; color[2] = 0.0f; }
+    else if (level <= 0.2f) { color[0] = 1.0f; color[1] = 1.0f; color[2] = 0.0f; }
+    else                    { color[0] = 0.0f; color[1] = 1.0f; color[2] = 0.0f; }
+    color[3] = 1.0f;
+
+    // FILL varijanta quad.frag odbacuje TexCoord.x < 1 - level, tj. ostaje desni deo sirine 2 * w * level
+    float left = x + w - 2.0f * w * std::min(std::max(level, 0.0f), 1.0f);
+
+    Command cmd;
+    if (!pixelRect(left, y - h, x + w, y + h, cmd))
+        return;
+
+    cmd.type = CommandType::Solid;
+    cmd.texture = nullptr;
+    cmd.u0 = cmd.du = cmd.v0 = cmd.dv = 0.0f;
+    std::memcpy(cmd.color, color, sizeof(color));
+    commands_.push_back(cmd);
+}
+
+void SoftwareRasterizer::renderTile(int tile) {
+    int tx0 = (tile % tilesX_) * tileSize_;
+    int ty0 = (tile / tilesX_) * tileSize_;
+    int tx1 = std::min(tx0 + tileSize_, width_);
+    int ty1 = std::min(ty0 + tileSize_, height_);
+
+    TexturedSpanFn texturedSpan = kernel().fn;
+
+    for (const Command& cmd : commands_) {
+        int x0 = std::max(cmd.x0, tx0), x1 = std::min(cmd.x1, tx1);
+        int y0 = std::max(cmd.y0, ty0), y1 = std::min(cmd.y1, ty1);
+        if (x0 >= x1 || y0 >= y1)
+            continue;
+
+        for (int y = y0; y < y1; ++y) {
+            std::uint32_t* dst = &color_[static_cast<std::size_t>(y) * width_ + x0];
+
+            if (cmd.type == CommandType::Clear) {
+                std::fill(dst, dst + (x1 - x0), packColor(cmd.color));
+                continue;
+            }
+            if (cmd.type == CommandType::Solid) {
+                solidSpan(dst, x1 - x0, cmd.color);
+                continue;
+            }
+
+            const SoftTexture& tex = *cmd.texture;
+            int row0, row1;
+            Span s;
+            sampleAxis(cmd.v0 + cmd.dv * static_cast<float>(y - cmd.y0), tex.height, tex.repeat, row0, row1, s.fy);
+
+            s.dst = dst;
+            s.count = x1 - x0;
+            s.row0 = &tex.texels[static_cast<std::size_t>(row0) * tex.width];
+            s.row1 = &tex.texels[static_cast<std::size_t>(row1) * tex.width];
+            s.texWidth = tex.width;
+            s.repeat = tex.repeat;
+            s.u = cmd.u0 + cmd.du * static_cast<float>(x0 - cmd.x0);
+            s.du = cmd.du;
+            std::memcpy(s.tint, cmd.color, sizeof(s.tint));
+            texturedSpan(s);
+        }
+    }
+}
+
+void SoftwareRasterizer::flush() {
+    if (commands_.empty())
+        return;
+
+    pool_.parallelFor(tilesX_ * tilesY_, [this](int tile) { renderTile(tile); });
+    commands_.clear();
+}
\ No newline at end of file
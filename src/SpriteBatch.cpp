@@ -0,0 +1,217 @@
+#include "SpriteBatch.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+SpriteBatch::SpriteBatch()
+    : shaders_(nullptr),
+      defaultShader_(0),
+      whiteTexture_(0),
+      VAO_(0),
+      VBO_(0),
+      EBO_(0),
+      capacity_(0),
+      layer_(0),
+      shader_(0),
+      lastDrawCalls_(0)
+{
+}
+
+bool SpriteBatch::init(ShaderVariants<ShaderProgram>& shaders, std::size_t initialQuads) {
+    shaders_ = &shaders;
+    defaultShader_ = shaders.get(SHADER_TEXTURED | SHADER_ALPHA_TEST).id();
+    shader_ = defaultShader_;
+
+    // 1x1 bela tekstura - netekstuirani quad-ovi (texture == 0) sa setShader sejderom
+    const unsigned char white[4] = { 255, 255, 255, 255 };
+    glGenTextures(1, &whiteTexture_);
+    glBindTexture(GL_TEXTURE_2D, whiteTexture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, white);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenVertexArrays(1, &VAO_);
+    glGenBuffers(1, &VBO_);
+    glGenBuffers(1, &EBO_);
+
+    glBindVertexArray(VAO_);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO_);
+
+    // position (layout = 0)
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, x));
+    glEnableVertexAttribArray(0);
+
+    // texture coord (layout = 1)
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, u));
+    glEnableVertexAttribArray(1);
+
+    // color (layout = 2)
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void*)offsetof(SpriteVertex, r));
+    glEnableVertexAttribArray(2);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO_);
+    glBindVertexArray(0);
+
+    ensureCapacity(initialQuads);
+    quads_.reserve(initialQuads);
+    vertices_.reserve(initialQuads * 4);
+
+    return defaultShader_ != 0 && whiteTexture_ != 0 && VAO_ != 0;
+}
+
+void SpriteBatch::destroy() {
+    if (EBO_) glDeleteBuffers(1, &EBO_);
+    if (VBO_) glDeleteBuffers(1, &VBO_);
+    if (VAO_) glDeleteVertexArrays(1, &VAO_);
+    if (whiteTexture_) glDeleteTextures(1, &whiteTexture_);
+    EBO_ = VBO_ = VAO_ = whiteTexture_ = 0;
+    capacity_ = 0;
+}
+
+void SpriteBatch::ensureCapacity(std::size_t quads) {
+    if (quads <= capacity_)
+        return;
+
+    std::size_t newCapacity = capacity_ ? capacity_ : 64;
+    while (newCapacity < quads) newCapacity *= 2;
+
+    // Indeksi su 16-bitni, 4 verteksa po quad-u
+    newCapacity = std::min<std::size_t>(newCapacity, 65536 / 4);
+
+    std::vector<std::uint16_t> indices(newCapacity * 6);
+    for (std::size_t i = 0; i < newCapacity; ++i) {
+        std::uint16_t base = static_cast<std::uint16_t>(i * 4);
+        indices[i * 6 + 0] = base + 0;
+        indices[i * 6 + 1] = base + 1;
+        indices[i * 6 + 2] = base + 2;
+        indices[i * 6 + 3] = base + 2;
+        indices[i * 6 + 4] = base + 3;
+        indices[i * 6 + 5] = base + 0;
+    }
+
+    glBindVertexArray(VAO_);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(std::uint16_t), indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO_);
+    glBufferData(GL_ARRAY_BUFFER, newCapacity * 4 * sizeof(SpriteVertex), nullptr, GL_STREAM_DRAW);
+    glBindVertexArray(0);
+
+    capacity_ = newCapacity;
+}
+
+void SpriteBatch::begin() {
+    quads_.clear();
+    layer_ = 0;
+    shader_ = defaultShader_;
+}
+
+void SpriteBatch::draw(GLuint texture, float x, float y, float w, float h,
+                       float uvX, float uvY, float uvW, float uvH,
+                       float r, float g, float b, float a)
+{
+    Quad q;
+    q.layer = layer_;
+    q.shader = shader_;
+    q.texture = texture ? texture : whiteTexture_;
+
+    // Jednobojni quad ne placa uzorkovanje ni alfa test
+    if (!texture && shader_ == defaultShader_) {
+        q.shader = shaders_->get(0).id();
+        q.texture = 0;
+    }
+    q.order = static_cast<unsigned>(quads_.size());
+    q.x = x; q.y = y; q.w = w; q.h = h;
+    q.uvX = uvX; q.uvY = uvY; q.uvW = uvW; q.uvH = uvH;
+    q.r = r; q.g = g; q.b = b; q.a = a;
+    quads_.push_back(q);
+}
+
+void SpriteBatch::draw(GLuint texture, const AtlasRegion& region, float x, float y, float w, float h,
+                       float r, float g, float b, float a)
+{
+    // Quad pokriva [x - w, x + w]; region.x0..x1 je deo tog opsega koji je ostao posle odsecanja
+    float cx = x + w * (region.x0 + region.x1 - 1.0f);
+    float cy = y + h * (region.y0 + region.y1 - 1.0f);
+    float cw = w * (region.x1 - region.x0);
+    float ch = h * (region.y1 - region.y0);
+
+    // Sprite sa strane maske je bele boje; njegova prava boja se mnozi u boju vrha
+    draw(texture, cx, cy, cw, ch,
+         region.u0, region.v0, region.u1 - region.u0, region.v1 - region.v0,
+         r * region.r, g * region.g, b * region.b, a);
+}
+
+void SpriteBatch::flush() {
+    lastDrawCalls_ = 0;
+    if (quads_.empty())
+        return;
+
+    std::sort(quads_.begin(), quads_.end(), [](const Quad& lhs, const Quad& rhs) {
+        if (lhs.layer != rhs.layer)     return lhs.layer < rhs.layer;
+        if (lhs.shader != rhs.shader)   return lhs.shader < rhs.shader;
+        if (lhs.texture != rhs.texture) return lhs.texture < rhs.texture;
+        return lhs.order < rhs.order;
+    });
+
+    // Preko 16-bitnih indeksa se crta u vise delova; sortirani redosled (i slojevi) ostaje isti
+    ensureCapacity(quads_.size());
+    for (std::size_t first = 0; first < quads_.size(); first += capacity_)
+        drawRange(first, std::min(quads_.size() - first, capacity_));
+
+    quads_.clear();
+}
+
+void SpriteBatch::drawRange(std::size_t first, std::size_t count) {
+    vertices_.clear();
+    for (std::size_t i = first; i < first + count; ++i) {
+        const Quad& q = quads_[i];
+        float x0 = q.x - q.w, x1 = q.x + q.w;
+        float y0 = q.y - q.h, y1 = q.y + q.h;
+        float u0 = q.uvX, u1 = q.uvX + q.uvW;
+        float v0 = q.uvY, v1 = q.uvY + q.uvH;
+
+        vertices_.push_back({ x0, y0, u0, v0, q.r, q.g, q.b, q.a });
+        vertices_.push_back({ x1, y0, u1, v0, q.r, q.g, q.b, q.a });
+        vertices_.push_back({ x1, y1, u1, v1, q.r, q.g, q.b, q.a });
+        vertices_.push_back({ x0, y1, u0, v1, q.r, q.g, q.b, q.a });
+    }
+
+    // Orphaning - drajver dobija novi blok memorije, nema cekanja na prethodni frejm
+    glBindBuffer(GL_ARRAY_BUFFER, VBO_);
+    glBufferData(GL_ARRAY_BUFFER, capacity_ * 4 * sizeof(SpriteVertex), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertices_.size() * sizeof(SpriteVertex), vertices_.data());
+
+    glBindVertexArray(VAO_);
+    glActiveTexture(GL_TEXTURE0);
+
+    GLuint boundShader = 0;
+    GLuint boundTexture = 0;
+    std::size_t runStart = first;
+    std::size_t end = first + count;
+
+    // Susedni quad-ovi sa istim shaderom i teksturom idu u jedan draw poziv, cak i preko granice slojeva
+    for (std::size_t i = first + 1; i <= end; ++i) {
+        bool endOfRun = (i == end) ||
+                        quads_[i].shader  != quads_[runStart].shader ||
+                        quads_[i].texture != quads_[runStart].texture;
+        if (!endOfRun)
+            continue;
+
+        const Quad& q = quads_[runStart];
+        if (q.shader != boundShader) {
+            glUseProgram(q.shader);
+            boundShader = q.shader;
+        }
+        if (q.texture != boundTexture) {
+            glBindTexture(GL_TEXTURE_2D, q.texture);
+            boundTexture = q.texture;
+        }
+
+        glDrawElements(GL_TRIANGLES, static_cast<GLsizei>((i - runStart) * 6), GL_UNSIGNED_SHORT,
+                       (void*)((runStart - first) * 6 * sizeof(std::uint16_t)));
+        ++lastDrawCalls_;
+        runStart = i;
+    }
+
+    glBindVertexArray(0);
+}
@@ -0,0 +1,21 @@
+#include "TextureAtlas.hpp"
+
+TextureAtlas::TextureAtlas() {
+    for (int i = 0; i < kAtlasPageCount; ++i) pages_[i] = 0;
+}
+
+void TextureAtlas::load(TextureLoader& loader, int priority) {
+    for (int i = 0; i < kAtlasPageCount; ++i) {
+        // Jednokanalne strane su maske jednobojnih sprite-ova; boju nosi AtlasRegion
+        TextureFormat format = (kAtlasPageChannels[i] == 1) ? TextureFormat::Mask : TextureFormat::RGBA;
+        pages_[i] = loader.requestTexture(kAtlasPages[i], priority, false, format);
+
+        // Bez mipmapa i bez ponavljanja - susedni sprite-ovi ne smeju da se preliju jedan u drugi
+        glBindTexture(GL_TEXTURE_2D, pages_[i]);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
\ No newline at end of file
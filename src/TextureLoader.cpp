@@ -0,0 +1,368 @@
+#include "TextureLoader.hpp"
+#include "MaskImage.hpp"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+TextureLoader::TextureLoader()
+    : nextJob_(0),
+      stop_(false),
+      pbo_(0),
+      pendingTextures_(0)
+{
+}
+
+TextureLoader::~TextureLoader() {
+    stop_ = true;
+    for (std::thread& worker : workers_)
+        worker.join();
+    workers_.clear();
+}
+
+GLuint TextureLoader::requestTexture(const char* filePath, int priority, bool mipmaps, TextureFormat format) {
+    // AutoMask krece kao RGBA; upload prelazi na GL_R8 ako radna nit nadje jednobojnu sliku
+    Texture tex = {};
+    glGenTextures(1, &tex.id);
+    tex.target = GL_TEXTURE_2D;
+    tex.internalFormat = (format == TextureFormat::Mask) ? GL_R8 : GL_RGBA8;
+    tex.format = (format == TextureFormat::Mask) ? GL_RED : GL_RGBA;
+    tex.channels = (format == TextureFormat::Mask) ? 1 : 4;
+    tex.layers = 1;
+    tex.pendingLayers = 1;
+    tex.priority = priority;
+    tex.mipmaps = mipmaps;
+
+    // Vezivanje pravi objekat sa ovim tipom, pa vlasnik odmah moze da postavi parametre
+    glBindTexture(GL_TEXTURE_2D, tex.id);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    std::unique_ptr<Job> job(new Job());
+    job->path = filePath;
+    job->texture = textures_.size();
+    job->layer = 0;
+    job->priority = priority;
+    job->channels = tex.channels;
+    job->detectMask = format == TextureFormat::AutoMask;
+
+    // Unos upakovan kao maska vazi za Mask i AutoMask; ostali moraju imati trazeni broj kanala
+    job->packed = assetPack().find(filePath);
+    if (job->packed) {
+        bool packedMask = (job->packed->flags & SWPAK_FLAG_MASK) != 0;
+        bool usable = packedMask ? format != TextureFormat::RGBA
+                                 : job->packed->channels == static_cast<std::uint32_t>(tex.channels);
+        if (!usable)
+            job->packed = nullptr;
+    }
+    jobs_.push_back(std::move(job));
+
+    textures_.push_back(tex);
+    ++pendingTextures_;
+    return tex.id;
+}
+
+GLuint TextureLoader::requestTextureArray(const char* const* filePaths, int count, int channels, int priority) {
+    Texture tex = {};
+    glGenTextures(1, &tex.id);
+    tex.target = GL_TEXTURE_2D_ARRAY;
+    tex.internalFormat = (channels == 1) ? GL_R8 : GL_RGBA8;
+    tex.format = (channels == 1) ? GL_RED : GL_RGBA;
+    tex.channels = (channels == 1) ? 1 : 4;
+    tex.layers = count;
+    tex.pendingLayers = count;
+    tex.priority = priority;
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, tex.id);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    for (int i = 0; i < count; ++i) {
+        std::unique_ptr<Job> job(new Job());
+        job->path = filePaths[i];
+        job->texture = textures_.size();
+        job->layer = i;
+        job->priority = priority;
+        job->channels = tex.channels;
+
+        // Sloj iz paketa mora imati isti format kao niz; inace se dekodira PNG
+        job->packed = assetPack().find(filePaths[i]);
+        if (job->packed && (job->packed->channels != static_cast<std::uint32_t>(tex.channels)))
+            job->packed = nullptr;
+        jobs_.push_back(std::move(job));
+    }
+
+    textures_.push_back(tex);
+    ++pendingTextures_;
+    return tex.id;
+}
+
+void TextureLoader::start(int threads) {
+    // Radne niti uzimaju poslove redom, pa redosled u jobs_ odredjuje sta se prvo dekodira
+    std::stable_sort(jobs_.begin(), jobs_.end(), [](const std::unique_ptr<Job>& lhs, const std::unique_ptr<Job>& rhs) {
+        return lhs->priority < rhs->priority;
+    });
+
+    // Upakovane slike su odmah spremne za upload; niti dekodiraju samo ostatak
+    decodeJobs_.clear();
+    for (std::unique_ptr<Job>& job : jobs_) {
+        if (job->packed) {
+            job->ok = true;
+            job->width = static_cast<int>(job->packed->width);
+            job->height = static_cast<int>(job->packed->height);
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready_.push_back(job.get());
+        } else {
+            decodeJobs_.push_back(job.get());
+        }
+    }
+    if (decodeJobs_.empty())
+        return;
+
+    if (threads <= 0)
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+    threads = std::max(1, std::min(threads, static_cast<int>(decodeJobs_.size())));
+
+    glGenBuffers(1, &pbo_);
+
+    nextJob_ = 0;
+    stop_ = false;
+    for (int i = 0; i < threads; ++i)
+        workers_.emplace_back(&TextureLoader::workerLoop, this);
+}
+
+void TextureLoader::workerLoop() {
+    while (!stop_) {
+        std::size_t index = nextJob_.fetch_add(1);
+        if (index >= decodeJobs_.size())
+            return;
+
+        Job& job = *decodeJobs_[index];
+        int channels;
+        unsigned char* data = stbi_load(job.path.c_str(), &job.width, &job.height, &channels, job.channels);
+        job.ok = data != nullptr;
+
+        if (data && job.detectMask) {
+            std::size_t pixelCount = static_cast<std::size_t>(job.width) * job.height;
+            job.mask = detectMaskColor(data, pixelCount, job.maskColor);
+            if (job.mask) {
+                extractMaskAlpha(data, pixelCount, data);
+                job.channels = 1;
+            }
+        }
+
+        if (data) {
+            // Slike se osnovno ucitavaju naopako - okrecu se ovde, ne na GL niti
+            std::size_t rowSize = static_cast<std::size_t>(job.width) * job.channels;
+            job.pixels.resize(rowSize * job.height);
+            for (int y = 0; y < job.height; ++y)
+                std::memcpy(&job.pixels[static_cast<std::size_t>(y) * rowSize],
+                            data + static_cast<std::size_t>(job.height - 1 - y) * rowSize, rowSize);
+            stbi_image_free(data);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready_.push_back(&job);
+        }
+        decoded_.notify_one();
+    }
+}
+
+void TextureLoader::upload(Job& job) {
+    Texture& tex = textures_[job.texture];
+    if (tex.failed)
+        return;
+
+    if (!job.ok) {
+        std::cout << "Textura nije ucitana! Putanja texture: " << job.path << std::endl;
+        tex.failed = true;
+        --pendingTextures_;
+        return;
+    }
+
+    if (tex.allocated && (job.width != tex.width || job.height != tex.height)) {
+        std::cout << "Sloj teksture nije istih dimenzija kao prvi! Putanja texture: " << job.path << std::endl;
+        tex.failed = true;
+        --pendingTextures_;
+        return;
+    }
+
+    if (job.packed) {
+        uploadPacked(job, tex);
+        return;
+    }
+
+    // Orphaning - svaki upload dobija novi blok, pa kopiranje ne ceka da GPU procita prethodni
+    GLsizeiptr size = static_cast<GLsizeiptr>(job.pixels.size());
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo_);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (mapped) {
+        std::memcpy(mapped, job.pixels.data(), job.pixels.size());
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
+    const void* source = mapped ? nullptr : job.pixels.data();
+    if (!mapped)
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (tex.target == GL_TEXTURE_2D && job.channels == 1) {
+        tex.internalFormat = GL_R8;
+        tex.format = GL_RED;
+        tex.channels = 1;
+    }
+
+    //Redovi jednokanalnih slika nisu poravnati na 4 bajta
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glBindTexture(tex.target, tex.id);
+
+    if (tex.target == GL_TEXTURE_2D_ARRAY) {
+        if (!tex.allocated) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, tex.internalFormat, job.width, job.height, tex.layers, 0,
+                         tex.format, GL_UNSIGNED_BYTE, nullptr);
+            if (mapped) glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo_);
+        }
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, job.layer, job.width, job.height, 1,
+                        tex.format, GL_UNSIGNED_BYTE, source);
+    } else {
+        glTexImage2D(GL_TEXTURE_2D, 0, tex.internalFormat, job.width, job.height, 0,
+                     tex.format, GL_UNSIGNED_BYTE, source);
+        if (tex.channels == 1)
+            setMask(tex, job.mask ? job.maskColor : nullptr);
+    }
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    tex.allocated = true;
+    tex.width = job.width;
+    tex.height = job.height;
+
+    if (--tex.pendingLayers == 0) {
+        if (tex.mipmaps)
+            glGenerateMipmap(tex.target);
+        --pendingTextures_;
+    }
+    glBindTexture(tex.target, 0);
+
+    // Dekodirani pikseli vise nisu potrebni
+    std::vector<unsigned char>().swap(job.pixels);
+}
+
+void TextureLoader::uploadPacked(Job& job, Texture& tex) {
+    const SwpakEntry& entry = *job.packed;
+    glBindTexture(tex.target, tex.id);
+
+    if (tex.target == GL_TEXTURE_2D_ARRAY) {
+        if (!tex.allocated)
+            glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, tex.internalFormat, job.width, job.height, tex.layers, 0,
+                         tex.format, GL_UNSIGNED_BYTE, nullptr);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, job.layer, job.width, job.height, 1,
+                        tex.format, GL_UNSIGNED_BYTE, assetPack().levelData(entry, 0));
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    } else {
+        // Mip nivoi su vec u paketu
+        assetPack().uploadTexture2D(entry);
+        if (entry.levels > 1)
+            tex.mipmaps = false;
+        if (entry.channels == 1)
+            setMask(tex, (entry.flags & SWPAK_FLAG_MASK) ? entry.maskColor : nullptr);
+    }
+
+    tex.allocated = true;
+    tex.width = job.width;
+    tex.height = job.height;
+
+    if (--tex.pendingLayers == 0) {
+        if (tex.mipmaps)
+            glGenerateMipmap(tex.target);
+        --pendingTextures_;
+    }
+    glBindTexture(tex.target, 0);
+}
+
+// Tekstura vezana na GL_TEXTURE_2D postaje maska: (1, 1, 1, R); rgb == nullptr je bela
+void TextureLoader::setMask(Texture& tex, const unsigned char* rgb) {
+    static const GLint swizzle[4] = { GL_ONE, GL_ONE, GL_ONE, GL_RED };
+    glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+
+    tex.mask = true;
+    for (int c = 0; c < 3; ++c)
+        tex.maskColor[c] = rgb ? rgb[c] / 255.0f : 1.0f;
+}
+
+int TextureLoader::pump() {
+    std::vector<Job*> batch;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        batch.swap(ready_);
+    }
+
+    std::stable_sort(batch.begin(), batch.end(), [](const Job* lhs, const Job* rhs) {
+        return lhs->priority < rhs->priority;
+    });
+    for (Job* job : batch)
+        upload(*job);
+
+    return pendingTextures_;
+}
+
+bool TextureLoader::texturesReady(int maxPriority, bool& outFailed) const {
+    outFailed = false;
+    for (const Texture& tex : textures_) {
+        if (tex.priority > maxPriority)
+            continue;
+        if (tex.failed)
+            outFailed = true;
+        else if (tex.pendingLayers > 0)
+            return false;
+    }
+    return true;
+}
+
+bool TextureLoader::waitFor(int maxPriority) {
+    bool failed = false;
+    for (;;) {
+        pump();
+        if (texturesReady(maxPriority, failed))
+            return !failed;
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        decoded_.wait(lock, [this] { return !ready_.empty(); });
+    }
+}
+
+bool TextureLoader::resident(GLuint texture) const {
+    for (const Texture& tex : textures_) {
+        if (tex.id == texture)
+            return !tex.failed && tex.pendingLayers == 0;
+    }
+    return false;
+}
+
+bool TextureLoader::maskColor(GLuint texture, float outRgb[3]) const {
+    for (const Texture& tex : textures_) {
+        if (tex.id != texture)
+            continue;
+        if (!tex.mask)
+            return false;
+        for (int c = 0; c < 3; ++c)
+            outRgb[c] = tex.maskColor[c];
+        return true;
+    }
+    return false;
+}
+
+void TextureLoader::destroy() {
+    stop_ = true;
+    for (std::thread& worker : workers_)
+        worker.join();
+    workers_.clear();
+
+    if (pbo_) glDeleteBuffers(1, &pbo_);
+    pbo_ = 0;
+    jobs_.clear();
+    decodeJobs_.clear();
+    ready_.clear();
+}
\ No newline at end of file
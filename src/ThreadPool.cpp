@@ -0,0 +1,93 @@
+#include "ThreadPool.hpp"
+
+ThreadPool::ThreadPool()
+    : job_(nullptr),
+      jobCount_(0),
+      nextJob_(0),
+      activeWorkers_(0),
+      generation_(0),
+      stop_(false)
+{
+}
+
+ThreadPool::~ThreadPool() {
+    destroy();
+}
+
+void ThreadPool::init(int threads) {
+    destroy();
+
+    if (threads <= 0)
+        threads = static_cast<int>(std::thread::hardware_concurrency());
+    if (threads <= 0)
+        threads = 1;
+
+    stop_ = false;
+    for (int i = 1; i < threads; ++i)
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+}
+
+void ThreadPool::destroy() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (std::thread& worker : workers_)
+        worker.join();
+    workers_.clear();
+}
+
+void ThreadPool::runJobs() {
+    for (;;) {
+        int i = nextJob_.fetch_add(1, std::memory_order_relaxed);
+        if (i >= jobCount_)
+            break;
+        (*job_)(i);
+    }
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& fn) {
+    if (count <= 0)
+        return;
+
+    if (workers_.empty() || count == 1) {
+        for (int i = 0; i < count; ++i) fn(i);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &fn;
+        jobCount_ = count;
+        nextJob_.store(0, std::memory_order_relaxed);
+        activeWorkers_ = static_cast<int>(workers_.size());
+        ++generation_;
+    }
+    wake_.notify_all();
+
+    runJobs();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return activeWorkers_ == 0; });
+    job_ = nullptr;
+}
+
+void ThreadPool::workerLoop() {
+    unsigned seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_)
+                return;
+            seen = generation_;
+        }
+
+        runJobs();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--activeWorkers_ == 0)
+            done_.notify_one();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+#include "TimerWheel.hpp"
+
+#include <limits>
+#include <utility>
+
+TimerWheel::TimerWheel()
+    : now_(0)
+{
+    reset();
+}
+
+void TimerWheel::reset() {
+    tasks_.clear();
+    free_.clear();
+    for (int slot = 0; slot < LEVELS * SLOTS; ++slot)
+        slots_[slot] = -1;
+    now_ = 0;
+}
+
+TimerWheel::TaskId TimerWheel::schedule(std::uint64_t delay, std::uint64_t period, Callback callback) {
+    TaskId id;
+    if (!free_.empty()) {
+        id = free_.back();
+        free_.pop_back();
+    } else {
+        id = static_cast<TaskId>(tasks_.size());
+        tasks_.emplace_back();
+    }
+
+    Task& task = tasks_[id];
+    task.due = now_ + (delay > 0 ? delay : 1);
+    task.period = period;
+    task.callback = std::move(callback);
+    link(id);
+    return id;
+}
+
+void TimerWheel::cancel(TaskId id) {
+    if (!active(id))
+        return;
+    unlink(id);
+    tasks_[id].callback = nullptr;
+    free_.push_back(id);
+}
+
+bool TimerWheel::active(TaskId id) const {
+    return id >= 0 && id < static_cast<TaskId>(tasks_.size()) && tasks_[id].slot >= 0;
+}
+
+std::uint64_t TimerWheel::nextDue() const {
+    std::uint64_t due = std::numeric_limits<std::uint64_t>::max();
+    for (const Task& task : tasks_)
+        if (task.slot >= 0 && task.due < due)
+            due = task.due;
+    return due;
+}
+
+void TimerWheel::skipTo(std::uint64_t tick) {
+    if (tick <= now_)
+        return;
+
+    // Unutar istog kruga nultog nivoa nema spustanja, pa je dovoljno pomeriti vreme
+    if (((now_ ^ tick) >> SLOT_BITS) == 0) {
+        now_ = tick;
+        return;
+    }
+
+    // Preskoceni krugovi nizih nivoa nisu spustili nista, pa se svi zadaci rasporedjuju iznova
+    // u odnosu na novo vreme
+    scratch_.clear();
+    for (TaskId id = 0; id < static_cast<TaskId>(tasks_.size()); ++id) {
+        if (tasks_[id].slot >= 0) {
+            unlink(id);
+            scratch_.push_back(id);
+        }
+    }
+    now_ = tick;
+    for (TaskId id : scratch_)
+        link(id);
+}
+
+void TimerWheel::link(TaskId id) {
+    Task& task = tasks_[id];
+    std::uint64_t delta = task.due - now_;
+
+    // Nivo je prvi u koji rok staje; slot je odgovarajuca grupa bitova roka. Rok dalji od
+    // najviseg nivoa ide u njegov poslednji slot i ponovo se rasporedjuje kada do njega dodje.
+    int level = 0;
+    while (level < LEVELS - 1 && delta >= (std::uint64_t(1) << (SLOT_BITS * (level + 1))))
+        ++level;
+
+    std::uint64_t tick = task.due;
+    std::uint64_t limit = std::uint64_t(1) << (SLOT_BITS * LEVELS);
+    if (delta >= limit)
+        tick = now_ + limit - 1;
+
+    task.slot = level * SLOTS + static_cast<int>((tick >> (SLOT_BITS * level)) & SLOT_MASK);
+    task.prev = -1;
+    task.next = slots_[task.slot];
+    if (task.next >= 0)
+        tasks_[task.next].prev = id;
+    slots_[task.slot] = id;
+}
+
+void TimerWheel::unlink(TaskId id) {
+    Task& task = tasks_[id];
+    if (task.prev >= 0)
+        tasks_[task.prev].next = task.next;
+    else
+        slots_[task.slot] = task.next;
+    if (task.next >= 0)
+        tasks_[task.next].prev = task.prev;
+    task.slot = -1;
+    task.prev = task.next = -1;
+}
+
+void TimerWheel::cascade(int level) {
+    int slot = level * SLOTS + static_cast<int>((now_ >> (SLOT_BITS * level)) & SLOT_MASK);
+    while (slots_[slot] >= 0) {
+        TaskId id = slots_[slot];
+        unlink(id);
+        link(id);
+    }
+}
+
+void TimerWheel::advance() {
+    ++now_;
+
+    // Kada nizi nivo zavrsi krug, slot viseg nivoa se spusta - prvo najvisi, da bi zadaci
+    // koje on spusti u srednji nivo bili spusteni i iz njega u istom otkucaju
+    int top = 0;
+    while (top < LEVELS - 1 && (now_ & ((std::uint64_t(1) << (SLOT_BITS * (top + 1))) - 1)) == 0)
+        ++top;
+    for (int level = top; level > 0; --level)
+        cascade(level);
+
+    int slot = static_cast<int>(now_ & SLOT_MASK);
+    while (slots_[slot] >= 0) {
+        TaskId id = slots_[slot];
+        unlink(id);
+
+        Task& task = tasks_[id];
+        if (task.due != now_) {
+            // Rok dalji od najviseg nivoa - jos jedan krug
+            link(id);
+            continue;
+        }
+
+        // Periodicni zadatak se zakazuje pre poziva, da bi mogao sam sebe da otkaze
+        if (task.period > 0) {
+            task.due += task.period;
+            link(id);
+            Callback callback = task.callback;
+            callback();
+        } else {
+            Callback callback = std::move(task.callback);
+            task.callback = nullptr;
+            free_.push_back(id);
+            callback();
+        }
+    }
+}
@@ -1,4 +1,6 @@
 #include "Util.hpp"
+#include "AssetPack.hpp"
+#include "ProgramCache.hpp"
 
 #define _CRT_SECURE_NO_WARNINGS
 #include <fstream>
@@ -10,10 +12,9 @@
 
 // Autor: Nedeljko Tesanovic
 // Opis: pomocne funkcije za ucitavanje sejdera i tekstura
-unsigned int compileShader(GLenum type, const char* source)
+static std::string readShaderSource(const char* source)
 {
-    //Uzima kod u fajlu na putanji "source", kompajlira ga i vraca sejder tipa "type"
-    //Citanje izvornog koda iz fajla
+    //Citanje izvornog koda iz fajla na putanji "source"
     std::string content = "";
     std::ifstream file(source);
     std::stringstream ss;
@@ -27,8 +28,25 @@ unsigned int compileShader(GLenum type, const char* source)
         ss << "";
         std::cout << "Greska pri citanju fajla sa putanje \"" << source << "\"!" << std::endl;
     }
-    std::string temp = ss.str();
-    const char* sourceCode = temp.c_str(); //Izvorni kod sejdera koji citamo iz fajla na putanji "source"
+    return ss.str();
+}
+static void insertDefines(std::string& code, const char* defines)
+{
+    //Definicije moraju ici posle #version direktive, koja je uvek prva linija
+    if (!defines || !*defines)
+        return;
+    std::string::size_type position = 0;
+    if (code.compare(0, 8, "#version") == 0)
+    {
+        position = code.find('\n');
+        position = (position == std::string::npos) ? code.size() : position + 1;
+    }
+    code.insert(position, defines);
+}
+unsigned int compileShader(GLenum type, const std::string& source)
+{
+    //Kompajlira izvorni kod "source" i vraca sejder tipa "type"
+    const char* sourceCode = source.c_str();
 
     int shader = glCreateShader(type); //Napravimo prazan sejder odredjenog tipa (vertex ili fragment)
 
@@ -46,11 +64,11 @@ unsigned int compileShader(GLenum type, const char* source)
         else if (type == GL_FRAGMENT_SHADER)
             printf("FRAGMENT");
         printf(" sejder ima gresku! Greska: \n");
-        printf(infoLog);
+        printf("%s", infoLog);
     }
     return shader;
 }
-unsigned int createShader(const char* vsSource, const char* fsSource)
+ShaderProgram createShader(const char* vsSource, const char* fsSource, const char* defines)
 {
     //Pravi objedinjeni sejder program koji se sastoji od Vertex sejdera ciji je kod na putanji vsSource
 
@@ -58,25 +76,36 @@ unsigned int createShader(const char* vsSource, const char* fsSource)
     unsigned int vertexShader; //Verteks sejder (za prostorne podatke)
     unsigned int fragmentShader; //Fragment sejder (za boje, teksture itd)
 
+    std::string vertexCode = readShaderSource(vsSource);
+    std::string fragmentCode = readShaderSource(fsSource);
+    insertDefines(vertexCode, defines);
+    insertDefines(fragmentCode, defines);
+
+    //Brzi put: program sa istim izvornim kodom je vec linkovan ranije na ovom drajveru
+    std::uint64_t cacheKey = programCache().key(vertexCode, fragmentCode);
+    program = programCache().load(cacheKey);
+    if (program)
+        return ShaderProgram::fromLinked(program);
+
     program = glCreateProgram(); //Napravi prazan objedinjeni sejder program
 
-    vertexShader = compileShader(GL_VERTEX_SHADER, vsSource); //Napravi i kompajliraj vertex sejder
-    fragmentShader = compileShader(GL_FRAGMENT_SHADER, fsSource); //Napravi i kompajliraj fragment sejder
+    vertexShader = compileShader(GL_VERTEX_SHADER, vertexCode); //Napravi i kompajliraj vertex sejder
+    fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentCode); //Napravi i kompajliraj fragment sejder
 
     //Zakaci verteks i fragment sejdere za objedinjeni program
     glAttachShader(program, vertexShader);
     glAttachShader(program, fragmentShader);
 
+    programCache().prepare(program, cacheKey);
     glLinkProgram(program); //Povezi ih u jedan objedinjeni sejder program
-    glValidateProgram(program); //Izvrsi provjeru novopecenog programa
 
     int success;
     char infoLog[512];
-    glGetProgramiv(program, GL_VALIDATE_STATUS, &success); //Slicno kao za sejdere
+    glGetProgramiv(program, GL_LINK_STATUS, &success); //Slicno kao za sejdere
     if (success == GL_FALSE)
     {
-        glGetShaderInfoLog(program, 512, NULL, infoLog);
-        std::cout << "Objedinjeni sejder ima gresku! Greska: \n";
+        glGetProgramInfoLog(program, 512, NULL, infoLog); //Za program se koristi glGetProgramInfoLog, ne glGetShaderInfoLog
+        std::cout << "Objedinjeni sejder nije linkovan (" << vsSource << ", " << fsSource << ")! Greska: \n";
         std::cout << infoLog << std::endl;
     }
 
@@ -86,10 +115,41 @@ unsigned int createShader(const char* vsSource, const char* fsSource)
     glDetachShader(program, fragmentShader);
     glDeleteShader(fragmentShader);
 
-    return program;
+    if (success == GL_FALSE)
+    {
+        glDeleteProgram(program);
+        return ShaderProgram();
+    }
+
+    glValidateProgram(program); //Izvrsi provjeru novopecenog programa
+    glGetProgramiv(program, GL_VALIDATE_STATUS, &success);
+    if (success == GL_FALSE)
+    {
+        //Validacija zavisi od trenutnog GL stanja (npr. bez vezanog VAO), pa je samo upozorenje
+        glGetProgramInfoLog(program, 512, NULL, infoLog);
+        std::cout << "Upozorenje pri validaciji sejdera (" << vsSource << ", " << fsSource << "): \n";
+        std::cout << infoLog << std::endl;
+    }
+
+    programCache().store(program, cacheKey);
+
+    //Jednom procitaj sve aktivne uniforme i atribute, render petlja vise ne trazi lokacije po imenu
+    return ShaderProgram::fromLinked(program);
 }
 
 unsigned loadImageToTexture(const char* filePath) {
+    //Brzi put: slika je vec dekodirana i okrenuta u .swpak paketu (maske ne - ovde nema ko da doda boju)
+    const SwpakEntry* Packed = assetPack().find(filePath);
+    if (Packed && !(Packed->flags & SWPAK_FLAG_MASK))
+    {
+        unsigned int Texture;
+        glGenTextures(1, &Texture);
+        glBindTexture(GL_TEXTURE_2D, Texture);
+        assetPack().uploadTexture2D(*Packed);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return Texture;
+    }
+
     int TextureWidth;
     int TextureHeight;
     int TextureChannels;
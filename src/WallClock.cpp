@@ -0,0 +1,208 @@
+#include "WallClock.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstdint>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
+
+static const int SECONDS_PER_DAY = 24 * 3600;
+
+TimeOfDay TimeOfDay::fromSecond(int secondOfDay) {
+    TimeOfDay t;
+    t.hh = secondOfDay / 3600;
+    t.mm = secondOfDay / 60 % 60;
+    t.ss = secondOfDay % 60;
+    return t;
+}
+
+bool parseTimeOfDay(const char* text, int& outSecond) {
+    int hh, mm, ss;
+    char tail;
+    if (std::sscanf(text, "%d:%d:%d%c", &hh, &mm, &ss, &tail) != 3 ||
+        hh < 0 || hh > 23 || mm < 0 || mm > 59 || ss < 0 || ss > 59)
+        return false;
+    outSecond = hh * 3600 + mm * 60 + ss;
+    return true;
+}
+
+// Lokalna sekunda u danu za sekundu od epohe
+static int localSecondOfDay(std::time_t seconds) {
+    std::tm local;
+    localtime_r(&seconds, &local);
+    return local.tm_hour * 3600 + local.tm_min * 60 + local.tm_sec;
+}
+
+// CLOCK_REALTIME: cele sekunde i deo sekunde
+static std::time_t realtimeNow(double& outFraction) {
+    std::timespec ts;
+    std::timespec_get(&ts, TIME_UTC);
+    outFraction = ts.tv_nsec * 1e-9;
+    return ts.tv_sec;
+}
+
+WallClock::WallClock()
+    : epoch_(DEFAULT_EPOCH),
+      startTime_(0.0),
+      tickedSecond_(DEFAULT_EPOCH),
+      nextSecond_(0),
+      timerFd_(-1),
+      stopFd_(-1),
+      clock_(nullptr),
+      onTick_(nullptr)
+{
+}
+
+WallClock::~WallClock() {
+    stopTicker();
+}
+
+void WallClock::init(int epoch, double startTime) {
+    stopTicker();
+    epoch_ = epoch;
+    startTime_ = startTime;
+    tickedSecond_.store(secondOfDay(startTime), std::memory_order_relaxed);
+}
+
+int WallClock::secondOfDay(double time) const {
+    if (system()) {
+        double fraction;
+        return localSecondOfDay(realtimeNow(fraction));
+    }
+    // Iz proteklog vremena, ne brojanjem otkucaja - greska se ne nagomilava
+    long long elapsed = static_cast<long long>(std::floor(time - startTime_));
+    long long second = (epoch_ + elapsed) % SECONDS_PER_DAY;
+    return static_cast<int>(second < 0 ? second + SECONDS_PER_DAY : second);
+}
+
+double WallClock::untilNextSecond(double time) const {
+    double fraction;
+    if (system())
+        realtimeNow(fraction);
+    else
+        fraction = (time - startTime_) - std::floor(time - startTime_);
+    return 1.0 - fraction;
+}
+
+#ifdef __linux__
+
+bool WallClock::startTicker(double (*clock)(), void (*onTick)()) {
+    if (ticking())
+        return true;
+
+    // Sistemski sat ide po CLOCK_REALTIME (granice sekundi su granice lokalnog vremena),
+    // simulirani po istom satu kao glfwGetTime
+    timerFd_ = timerfd_create(system() ? CLOCK_REALTIME : CLOCK_MONOTONIC, TFD_CLOEXEC);
+    stopFd_ = eventfd(0, EFD_CLOEXEC);
+    clock_ = clock;
+    onTick_ = onTick;
+
+    if (timerFd_ < 0 || stopFd_ < 0 || !armTimer()) {
+        stopTicker();
+        return false;
+    }
+
+    thread_ = std::thread(&WallClock::tickerLoop, this);
+    return true;
+}
+
+void WallClock::stopTicker() {
+    if (ticking()) {
+        std::uint64_t one = 1;
+        ssize_t written = write(stopFd_, &one, sizeof(one));
+        (void)written;
+        thread_.join();
+    }
+    if (timerFd_ >= 0) close(timerFd_);
+    if (stopFd_ >= 0)  close(stopFd_);
+    timerFd_ = -1;
+    stopFd_ = -1;
+}
+
+bool WallClock::armTimer() {
+    // Apsolutni rok na sledecoj celoj sekundi pa period od tacno sekunde - kasno budjenje ne
+    // pomera sledeci otkucaj, a propusteni otkucaji se vide u broju isteka
+    std::timespec now;
+    itimerspec spec = {};
+    spec.it_interval.tv_sec = 1;
+    int flags = TFD_TIMER_ABSTIME;
+
+    if (system()) {
+        clock_gettime(CLOCK_REALTIME, &now);
+        spec.it_value.tv_sec = now.tv_sec + 1;
+        // Rucno pomeranje sistemskog vremena prekida cekanje (ECANCELED) da bi se tajmer ponovo poravnao
+        flags |= TFD_TIMER_CANCEL_ON_SET;
+    } else {
+        double time = clock_();
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        long long target = static_cast<long long>(now.tv_sec) * 1000000000LL + now.tv_nsec
+                         + std::llround(untilNextSecond(time) * 1e9);
+        spec.it_value.tv_sec = static_cast<time_t>(target / 1000000000LL);
+        spec.it_value.tv_nsec = static_cast<long>(target % 1000000000LL);
+        nextSecond_ = (secondOfDay(time) + 1) % SECONDS_PER_DAY;
+    }
+
+    if (timerfd_settime(timerFd_, flags, &spec, nullptr) != 0)
+        return false;
+    tickedSecond_.store(system() ? secondOfDay(0.0) : (nextSecond_ + SECONDS_PER_DAY - 1) % SECONDS_PER_DAY,
+                        std::memory_order_release);
+    return true;
+}
+
+void WallClock::tickerLoop() {
+    pollfd fds[2] = { { timerFd_, POLLIN, 0 }, { stopFd_, POLLIN, 0 } };
+
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        if (fds[1].revents)
+            return;
+
+        std::uint64_t expirations = 0;
+        if (read(timerFd_, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+            if (errno == ECANCELED && armTimer() && onTick_)
+                onTick_();
+            continue;
+        }
+
+        if (system()) {
+            // Budjenje je posle granice, pa je trenutna sekunda vec nova (i prati promene vremenske zone)
+            tickedSecond_.store(secondOfDay(0.0), std::memory_order_release);
+        } else {
+            // Tajmer ide po istom satu kao simulirano vreme - sekunda je broj isteka, bez zaokruzivanja
+            int second = static_cast<int>((nextSecond_ + expirations - 1) % SECONDS_PER_DAY);
+            nextSecond_ = (second + 1) % SECONDS_PER_DAY;
+            tickedSecond_.store(second, std::memory_order_release);
+        }
+
+        if (onTick_)
+            onTick_();
+    }
+}
+
+#else
+
+bool WallClock::startTicker(double (*)(), void (*)()) {
+    return false;
+}
+
+void WallClock::stopTicker() {
+}
+
+bool WallClock::armTimer() {
+    return false;
+}
+
+void WallClock::tickerLoop() {
+}
+
+#endif
@@ -0,0 +1,296 @@
+#include "WatchSimulation.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+WatchSimulation::WatchSimulation()
+    : rate_(DEFAULT_RATE),
+      stepTime_(1.0 / DEFAULT_RATE),
+      startTime_(0.0),
+      lastTime_(0.0),
+      accumulator_(0.0),
+      steps_(0),
+      running_(false),
+      ecgInput_(nullptr),
+      ecgOutput_(nullptr),
+      ecgTimeOffset_(0.0),
+      ecgTimeSynced_(false),
+      ecgLastForwarded_(0.0),
+      qrsReady_(false),
+      qrsBeatTime_(0.0),
+      batteryTask_(TimerWheel::INVALID_TASK),
+      randBpm_(60.0f, 80.0f)
+{
+}
+
+void WatchSimulation::init(double startTime, double rate, unsigned seed) {
+    rate_ = rate > 0.0 ? rate : DEFAULT_RATE;
+    stepTime_ = 1.0 / rate_;
+    startTime_ = startTime;
+    lastTime_ = startTime;
+    accumulator_ = 0.0;
+    steps_ = 0;
+    rng_.seed(seed);
+
+    current_ = WatchState();
+    current_.time = startTime;
+    current_.bpmTarget = randBpm_(rng_);
+    current_.running = running_;
+
+    qrsReady_ = false;
+    qrsBeatTime_ = startTime;
+    rateProbe_.clear();
+    ecgTimeSynced_ = false;
+    ecgLastForwarded_ = -std::numeric_limits<double>::infinity();
+
+    EcgSynthParams synth;
+    synth.sampleRate = SYNTH_RATE;
+    synth.bpm = current_.bpm;
+    synth.seed = seed;
+    synth_.init(synth, startTime);
+
+    timers_.reset();
+    batteryTask_ = schedule(BATTERY_PERIOD, BATTERY_PERIOD, [](WatchState& state) {
+        state.batteryLevel = std::max(0.0f, state.batteryLevel - 0.01f);
+    });
+    schedule(RETARGET_PERIOD, RETARGET_PERIOD, [this](WatchState& state) {
+        if (!state.running)
+            state.bpmTarget = randBpm_(rng_);
+    });
+    current_.nextBatteryDrop = startTime_ + static_cast<double>(timers_.dueTick(batteryTask_)) * stepTime_;
+    previous_ = current_;
+}
+
+TimerWheel::TaskId WatchSimulation::schedule(double delay, double period, Task task) {
+    // Zadatak uvek radi nad stanjem koje se upravo koraca
+    return timers_.schedule(toSteps(delay), period > 0.0 ? std::max<std::uint64_t>(1, toSteps(period)) : 0,
+                            [this, task = std::move(task)]() { task(current_); });
+}
+
+std::uint64_t WatchSimulation::toSteps(double seconds) const {
+    return static_cast<std::uint64_t>(std::llround(std::max(0.0, seconds) * rate_));
+}
+
+int WatchSimulation::advance(double currentTime) {
+    double elapsed = currentTime - lastTime_;
+    lastTime_ = currentTime;
+    if (elapsed <= 0.0)
+        return 0;
+
+    // Preskoceno vreme se ne simulira; vremenska osa se pomera da ostane poravnata sa pozivaocem
+    if (elapsed > MAX_CATCH_UP) {
+        double skipped = elapsed - MAX_CATCH_UP;
+        startTime_ += skipped;
+        for (WatchState* state : { &previous_, &current_ }) {
+            state->time += skipped;
+            state->nextBatteryDrop += skipped;
+        }
+        elapsed = MAX_CATCH_UP;
+    }
+
+    accumulator_ += elapsed;
+    int count = 0;
+    while (accumulator_ >= stepTime_) {
+        previous_ = current_;
+        step();
+        accumulator_ -= stepTime_;
+        ++count;
+    }
+    return count;
+}
+
+std::uint64_t WatchSimulation::fastForward(double duration) {
+    std::uint64_t target = steps_ + toSteps(duration);
+    std::uint64_t begin = steps_;
+
+    while (steps_ < target) {
+        // Otkucaj tocka je broj koraka; do sledeceg roka (ili kraja) nema diskretnih promena
+        std::uint64_t next = std::min(timers_.nextDue(), target);
+        if (next > steps_ + 1)
+            skipSteps(next - 1 - steps_);
+        previous_ = current_;
+        step();
+    }
+
+    // Vreme pozivaoca se nastavlja od poslednjeg koraka
+    lastTime_ = current_.time;
+    accumulator_ = 0.0;
+    return steps_ - begin;
+}
+
+void WatchSimulation::skipSteps(std::uint64_t count) {
+    WatchState& state = current_;
+    const double dt = stepTime_;
+    const double n = static_cast<double>(count);
+
+    steps_ += count;
+    timers_.skipTo(timers_.now() + count);
+    state.time = startTime_ + static_cast<double>(steps_) * stepTime_;
+    state.running = running_;
+
+    const double speed = 0.2;
+    if (state.running)
+        state.squeezeScale = static_cast<float>(std::max(0.2, state.squeezeScale - speed * dt * n));
+    else
+        state.squeezeScale = static_cast<float>(std::min(1.0, state.squeezeScale + speed * dt * n));
+
+    expireEcgBpm(state);
+
+    // bpm[i] = T + (bpm[0] - T) * r^i, r = 1 - k * dt
+    bool measured = state.ecgBpm > 0.0f;
+    double target = measured ? state.ecgBpm : (state.running ? 220.0 : state.bpmTarget);
+    double r = 1.0 - (state.running && !measured ? 0.5 : 1.5) * dt;
+    double d0 = state.bpm - target;
+    double rn = std::pow(r, n);
+    state.bpm = static_cast<float>(target + d0 * rn);
+
+    if (!ecgInput_ && ecgOutput_)
+        synth_.skipTo(state.time);
+}
+
+void WatchSimulation::step() {
+    WatchState& state = current_;
+    ++steps_;
+    // Vreme iz broja koraka, ne sabiranjem - nema nagomilane greske zaokruzivanja
+    state.time = startTime_ + static_cast<double>(steps_) * stepTime_;
+    state.running = running_;
+    const float dt = static_cast<float>(stepTime_);
+
+    // Sat se steze dok se trci i opusta kada se pusti
+    const float speed = 0.2f; // promena po sekundi
+    if (state.running)
+        state.squeezeScale = std::max(0.2f, state.squeezeScale - speed * dt);
+    else
+        state.squeezeScale = std::min(1.0f, state.squeezeScale + speed * dt);
+
+    if (ecgInput_) {
+        drainEcg(state);
+        expireEcgBpm(state);
+    } else if (ecgOutput_) {
+        synthesizeEcg(state);
+    }
+
+    // Pad baterije, novi cilj BPM-a i ostali zakazani zadaci kojima je rok ovaj korak
+    timers_.advance();
+    state.nextBatteryDrop = startTime_ + static_cast<double>(timers_.dueTick(batteryTask_)) * stepTime_;
+
+    if (state.ecgBpm > 0.0f) {
+        // Izmereni puls ima prednost; ovde se samo izgladjuje izmedju otkucaja
+        state.bpm += (state.ecgBpm - state.bpm) * dt * 1.5f;
+    } else if (state.running) {
+        float target = 220.0f;
+        state.bpm += (target - state.bpm) * dt * 0.5f;
+    } else {
+        state.bpm += (state.bpmTarget - state.bpm) * dt * 1.5f;
+    }
+}
+
+void WatchSimulation::drainEcg(WatchState& state) {
+    // U blokovima, da se indeksi prstena ne citaju po uzorku
+    EcgSample block[64];
+    std::size_t count;
+    while ((count = ecgInput_->pop(block, 64)) > 0) {
+        state.ecgValue = block[count - 1].value;
+        state.ecgSamples += count;
+        detectQrs(block, count, state);
+        if (ecgOutput_)
+            forwardEcg(block, count, state);
+    }
+}
+
+void WatchSimulation::forwardEcg(EcgSample* samples, std::size_t count, const WatchState& state) {
+    // Sat senzora i sat simulacije se razilaze; pomeraj se ponovo uzima kada razlika predje pola
+    // sekunde (npr. posle prekida veze ili zbog drugacijeg takta izvora)
+    double mapped = samples[count - 1].time + ecgTimeOffset_;
+    if (!ecgTimeSynced_ || std::fabs(mapped - state.time) > 0.5) {
+        ecgTimeOffset_ = state.time - samples[count - 1].time;
+        ecgTimeSynced_ = true;
+    }
+    // Posle pomeraja unazad (senzor je odmakao) uzorci koji padaju pre vec poslatih se ne salju:
+    // vremena u tragu moraju da rastu, EkgTrace trazi vidljivi opseg binarnom pretragom
+    for (std::size_t i = 0; i < count; ++i) {
+        double time = samples[i].time + ecgTimeOffset_;
+        if (time < ecgLastForwarded_)
+            continue;
+        samples[i].time = time;
+        ecgLastForwarded_ = time;
+        ecgOutput_->push(samples[i]);
+    }
+}
+
+void WatchSimulation::expireEcgBpm(WatchState& state) {
+    if (state.ecgBpm <= 0.0f)
+        return;
+    double timeout = std::max(ECG_BPM_TIMEOUT, ECG_BPM_TIMEOUT_RR * 60.0 / state.ecgBpm);
+    if (state.time - qrsBeatTime_ < timeout)
+        return;
+
+    // BPM se vraca na model (mirovanje/trcanje); R-R istorija pre prekida se ne mesa sa novom
+    state.ecgBpm = 0.0f;
+    if (qrsReady_)
+        qrs_.init(qrs_.sampleRate());
+}
+
+void WatchSimulation::synthesizeEcg(WatchState& state) {
+    // Uzorci do vremena ovog koraka, po BPM-u prethodnog
+    synth_.setBpm(state.bpm);
+    double pending = (state.time - synth_.time()) * synth_.sampleRate();
+    if (pending < 0.0)
+        return;
+
+    std::size_t remaining = static_cast<std::size_t>(pending) + 1;
+    EcgSample block[64];
+    while (remaining > 0) {
+        std::size_t count = std::min<std::size_t>(remaining, 64);
+        synth_.generate(block, count);
+        for (std::size_t i = 0; i < count; ++i)
+            ecgOutput_->push(block[i]);
+        state.ecgValue = block[count - 1].value;
+        remaining -= count;
+    }
+}
+
+void WatchSimulation::detectQrs(const EcgSample* samples, std::size_t count, WatchState& state) {
+    if (!qrsReady_) {
+        rateProbe_.insert(rateProbe_.end(), samples, samples + count);
+        if (rateProbe_.size() < static_cast<std::size_t>(RATE_PROBE))
+            return;
+
+        double span = rateProbe_.back().time - rateProbe_.front().time;
+        double sampleRate = span > 0.0 ? (rateProbe_.size() - 1) / span : 0.0;
+        if (sampleRate <= 0.0) {
+            // Vremena ne rastu - izvor nije upotrebljiv za detekciju
+            rateProbe_.clear();
+            return;
+        }
+        qrs_.init(std::round(sampleRate));
+        qrsReady_ = true;
+        samples = rateProbe_.data();
+        count = rateProbe_.size();
+    }
+
+    qrsInput_.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+        qrsInput_[i] = samples[i].value;
+    if (qrs_.process(qrsInput_.data(), static_cast<int>(count)) > 0) {
+        state.ecgBpm = static_cast<float>(qrs_.bpm());
+        qrsBeatTime_ = state.time;
+    }
+
+    if (samples == rateProbe_.data())
+        rateProbe_.clear();
+}
+
+void WatchSimulation::interpolate(WatchState& outState) const {
+    interpolateState(previous_, current_, alpha(), outState);
+}
+
+void interpolateState(const WatchState& from, const WatchState& to, double alpha, WatchState& outState) {
+    float a = static_cast<float>(alpha);
+    outState = to;
+    outState.time = from.time + (to.time - from.time) * alpha;
+    outState.bpm = from.bpm + (to.bpm - from.bpm) * a;
+    outState.squeezeScale = from.squeezeScale + (to.squeezeScale - from.squeezeScale) * a;
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+#pragma once
+
+// Minimalni PNG enkoder za offline alate (atlas, SDF).
+// Deflate sa fiksnim Huffman kodovima i pohlepnim LZ77 - dovoljno za slike sa dosta praznog prostora.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace png_writer {
+
+struct BitWriter {
+    std::vector<unsigned char>& out;
+    std::uint32_t bits = 0;
+    int count = 0;
+
+    explicit BitWriter(std::vector<unsigned char>& o) : out(o) {}
+
+    void put(std::uint32_t value, int n) {
+        bits |= value << count;
+        count += n;
+        while (count >= 8) {
+            out.push_back(static_cast<unsigned char>(bits & 0xFF));
+            bits >>= 8;
+            count -= 8;
+        }
+    }
+
+    // Huffman kodovi se pisu od najznacajnijeg bita
+    void putReversed(std::uint32_t code, int n) {
+        std::uint32_t r = 0;
+        for (int i = 0; i < n; ++i) r |= ((code >> i) & 1u) << (n - 1 - i);
+        put(r, n);
+    }
+
+    void flush() {
+        if (count > 0) out.push_back(static_cast<unsigned char>(bits & 0xFF));
+        bits = 0;
+        count = 0;
+    }
+};
+
+inline void putLiteral(BitWriter& bw, int lit) {
+    if (lit <= 143)      bw.putReversed(0x30 + lit, 8);
+    else if (lit <= 255) bw.putReversed(0x190 + (lit - 144), 9);
+    else if (lit <= 279) bw.putReversed(lit - 256, 7);
+    else                 bw.putReversed(0xC0 + (lit - 280), 8);
+}
+
+inline void putMatch(BitWriter& bw, int length, int distance) {
+    static const int lenBase[29]  = { 3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258 };
+    static const int lenExtra[29] = { 0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0 };
+    static const int distBase[30] = { 1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577 };
+    static const int distExtra[30]= { 0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13 };
+
+    int li = 28;
+    while (lenBase[li] > length) --li;
+    putLiteral(bw, 257 + li);
+    if (lenExtra[li]) bw.put(length - lenBase[li], lenExtra[li]);
+
+    int di = 29;
+    while (distBase[di] > distance) --di;
+    bw.putReversed(di, 5);
+    if (distExtra[di]) bw.put(distance - distBase[di], distExtra[di]);
+}
+
+inline std::vector<unsigned char> deflate(const std::vector<unsigned char>& data) {
+    std::vector<unsigned char> out;
+    BitWriter bw(out);
+    bw.put(1, 1); // BFINAL
+    bw.put(1, 2); // BTYPE = fiksni Huffman
+
+    const int window = 32768;
+    const int hashSize = 1 << 15;
+    std::vector<int> head(hashSize, -1);
+    std::vector<int> prev(data.size(), -1);
+
+    auto hash3 = [&](std::size_t i) {
+        return ((data[i] << 10) ^ (data[i + 1] << 5) ^ data[i + 2]) & (hashSize - 1);
+    };
+
+    std::size_t i = 0;
+    const std::size_t n = data.size();
+    while (i < n) {
+        int bestLen = 0, bestDist = 0;
+        if (i + 2 < n) {
+            int h = hash3(i);
+            int candidate = head[h];
+            int chain = 32;
+            while (candidate >= 0 && static_cast<int>(i) - candidate <= window && chain-- > 0) {
+                int len = 0;
+                int maxLen = static_cast<int>(std::min<std::size_t>(258, n - i));
+                while (len < maxLen && data[candidate + len] == data[i + len]) ++len;
+                if (len > bestLen) {
+                    bestLen = len;
+                    bestDist = static_cast<int>(i) - candidate;
+                    if (len == maxLen) break;
+                }
+                candidate = prev[candidate];
+            }
+        }
+
+        std::size_t advance = 1;
+        if (bestLen >= 3) {
+            putMatch(bw, bestLen, bestDist);
+            advance = static_cast<std::size_t>(bestLen);
+        } else {
+            putLiteral(bw, data[i]);
+        }
+
+        for (std::size_t k = 0; k < advance; ++k, ++i) {
+            if (i + 2 < n) {
+                int h = hash3(i);
+                prev[i] = head[h];
+                head[h] = static_cast<int>(i);
+            }
+        }
+    }
+
+    putLiteral(bw, 256); // kraj bloka
+    bw.flush();
+    return out;
+}
+
+inline std::uint32_t crc32(const unsigned char* data, std::size_t size, std::uint32_t crc = 0xFFFFFFFFu) {
+    for (std::size_t i = 0; i < size; ++i) {
+        crc ^= data[i];
+        for (int k = 0; k < 8; ++k) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+    return crc;
+}
+
+inline void putBE32(std::vector<unsigned char>& out, std::uint32_t v) {
+    out.push_back(static_cast<unsigned char>(v >> 24));
+    out.push_back(static_cast<unsigned char>(v >> 16));
+    out.push_back(static_cast<unsigned char>(v >> 8));
+    out.push_back(static_cast<unsigned char>(v));
+}
+
+inline void writeChunk(std::FILE* f, const char* type, const std::vector<unsigned char>& payload) {
+    std::vector<unsigned char> chunk;
+    putBE32(chunk, static_cast<std::uint32_t>(payload.size()));
+    chunk.insert(chunk.end(), type, type + 4);
+    chunk.insert(chunk.end(), payload.begin(), payload.end());
+    std::uint32_t crc = ~crc32(chunk.data() + 4, chunk.size() - 4);
+    putBE32(chunk, crc);
+    std::fwrite(chunk.data(), 1, chunk.size(), f);
+}
+
+// channels: 1 (grayscale), 3 (RGB) ili 4 (RGBA); redovi odozgo nadole
+inline bool writePng(const char* path, int width, int height, int channels, const unsigned char* pixels) {
+    std::vector<unsigned char> raw;
+    raw.reserve(static_cast<std::size_t>(height) * (width * channels + 1));
+    for (int y = 0; y < height; ++y) {
+        raw.push_back(0); // filter: none
+        const unsigned char* row = pixels + static_cast<std::size_t>(y) * width * channels;
+        raw.insert(raw.end(), row, row + width * channels);
+    }
+
+    std::vector<unsigned char> z;
+    z.push_back(0x78);
+    z.push_back(0x01);
+    std::vector<unsigned char> compressed = deflate(raw);
+    z.insert(z.end(), compressed.begin(), compressed.end());
+
+    std::uint32_t a = 1, b = 0;
+    for (unsigned char c : raw) {
+        a = (a + c) % 65521;
+        b = (b + a) % 65521;
+    }
+    putBE32(z, (b << 16) | a);
+
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) return false;
+
+    static const unsigned char signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+    std::fwrite(signature, 1, 8, f);
+
+    std::vector<unsigned char> ihdr;
+    putBE32(ihdr, static_cast<std::uint32_t>(width));
+    putBE32(ihdr, static_cast<std::uint32_t>(height));
+    ihdr.push_back(8);
+    ihdr.push_back(static_cast<unsigned char>(channels == 4 ? 6 : channels == 3 ? 2 : 0));
+    ihdr.push_back(0);
+    ihdr.push_back(0);
+    ihdr.push_back(0);
+
+    writeChunk(f, "IHDR", ihdr);
+    writeChunk(f, "IDAT", z);
+    writeChunk(f, "IEND", std::vector<unsigned char>());
+    std::fclose(f);
+    return true;
+}
+
+} // namespace png_writer
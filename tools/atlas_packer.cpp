@@ -0,0 +1,387 @@
+// Offline alat: pakuje PNG slike iz res/ u jednu ili vise atlas strana i generise tabelu UV pravougaonika.
+//
+//   atlas_packer --out res/atlas --header include/AtlasData.hpp [--max-size 2048] [--padding 2]
+//                [--scale 0.5] slika.png[:scale] ...
+//
+// Svaka slika se (opciono) umanji, odsece joj se providni okvir i spakuje se MaxRects algoritmom
+// (best short side fit). Tabela cuva i deo originalne slike koji je ostao posle odsecanja, pa renderer
+// crta sprite na istoj poziciji kao i pre pakovanja.
+// Jednobojne slike (MaskImage.hpp) idu na posebne jednokanalne strane - cuva se samo alfa, a boja
+// ide u tabelu i renderer je mnozi u boju vrha.
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#include "PngWriter.hpp"
+#include "MaskImage.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+struct Rect {
+    int x, y, w, h;
+};
+
+struct Sprite {
+    std::string path;
+    std::string id;
+    float scale;
+    int srcW, srcH;              // dimenzije posle skaliranja, pre odsecanja
+    int trimX, trimY, trimW, trimH;
+    std::vector<unsigned char> pixels; // RGBA, samo odseceni deo
+    bool mask;                   // jednobojna - ide na jednokanalnu stranu
+    unsigned char color[3];
+    int page;
+    Rect placed;
+};
+
+static std::string makeIdentifier(const std::string& path) {
+    std::string base = path.substr(path.find_last_of("/\\") + 1);
+    base = base.substr(0, base.find('.'));
+
+    std::string id;
+    bool upper = true;
+    for (char c : base) {
+        if (c == '_' || c == '-' || c == ' ') { upper = true; continue; }
+        id += upper ? static_cast<char>(std::toupper(static_cast<unsigned char>(c))) : c;
+        upper = false;
+    }
+    if (!id.empty() && std::isdigit(static_cast<unsigned char>(id[0]))) id = "Digit" + id;
+    return id;
+}
+
+// Umanjivanje usrednjavanjem po povrsini; boja se tezinski usrednjava alfom da providni pikseli ne potamne ivice
+static std::vector<unsigned char> resample(const unsigned char* src, int w, int h, int dw, int dh) {
+    std::vector<unsigned char> dst(static_cast<std::size_t>(dw) * dh * 4);
+    for (int y = 0; y < dh; ++y) {
+        int sy0 = y * h / dh, sy1 = std::max(sy0 + 1, (y + 1) * h / dh);
+        for (int x = 0; x < dw; ++x) {
+            int sx0 = x * w / dw, sx1 = std::max(sx0 + 1, (x + 1) * w / dw);
+            double r = 0, g = 0, b = 0, a = 0;
+            int n = 0;
+            for (int sy = sy0; sy < sy1; ++sy) {
+                for (int sx = sx0; sx < sx1; ++sx) {
+                    const unsigned char* p = src + (static_cast<std::size_t>(sy) * w + sx) * 4;
+                    double pa = p[3] / 255.0;
+                    r += p[0] * pa; g += p[1] * pa; b += p[2] * pa; a += pa;
+                    ++n;
+                }
+            }
+            unsigned char* d = dst.data() + (static_cast<std::size_t>(y) * dw + x) * 4;
+            if (a > 0.0) {
+                d[0] = static_cast<unsigned char>(std::lround(r / a));
+                d[1] = static_cast<unsigned char>(std::lround(g / a));
+                d[2] = static_cast<unsigned char>(std::lround(b / a));
+            } else {
+                d[0] = d[1] = d[2] = 0;
+            }
+            d[3] = static_cast<unsigned char>(std::lround(a / n * 255.0));
+        }
+    }
+    return dst;
+}
+
+static bool loadSprite(Sprite& s) {
+    int w, h, channels;
+    unsigned char* data = stbi_load(s.path.c_str(), &w, &h, &channels, 4);
+    if (!data) {
+        std::fprintf(stderr, "Slika nije ucitana: %s\n", s.path.c_str());
+        return false;
+    }
+
+    std::vector<unsigned char> scaled;
+    if (s.scale != 1.0f) {
+        s.srcW = std::max(1, static_cast<int>(std::lround(w * s.scale)));
+        s.srcH = std::max(1, static_cast<int>(std::lround(h * s.scale)));
+        scaled = resample(data, w, h, s.srcW, s.srcH);
+    } else {
+        s.srcW = w;
+        s.srcH = h;
+        scaled.assign(data, data + static_cast<std::size_t>(w) * h * 4);
+    }
+    stbi_image_free(data);
+
+    int x0 = s.srcW, y0 = s.srcH, x1 = -1, y1 = -1;
+    for (int y = 0; y < s.srcH; ++y) {
+        for (int x = 0; x < s.srcW; ++x) {
+            if (scaled[(static_cast<std::size_t>(y) * s.srcW + x) * 4 + 3] == 0) continue;
+            x0 = std::min(x0, x); x1 = std::max(x1, x);
+            y0 = std::min(y0, y); y1 = std::max(y1, y);
+        }
+    }
+    if (x1 < 0) { x0 = y0 = 0; x1 = y1 = 0; } // potpuno providna slika - ostaje 1x1
+
+    s.trimX = x0; s.trimY = y0;
+    s.trimW = x1 - x0 + 1; s.trimH = y1 - y0 + 1;
+    s.pixels.resize(static_cast<std::size_t>(s.trimW) * s.trimH * 4);
+    for (int y = 0; y < s.trimH; ++y) {
+        const unsigned char* row = scaled.data() + (static_cast<std::size_t>(y + y0) * s.srcW + x0) * 4;
+        std::copy(row, row + s.trimW * 4, s.pixels.begin() + static_cast<std::size_t>(y) * s.trimW * 4);
+    }
+
+    s.mask = detectMaskColor(s.pixels.data(), s.pixels.size() / 4, s.color);
+    return true;
+}
+
+// MaxRects bin packer, heuristika best short side fit
+class MaxRectsBin {
+public:
+    MaxRectsBin(int w, int h) { free_.push_back({ 0, 0, w, h }); }
+
+    bool insert(int w, int h, Rect& out) {
+        int bestShort = 1 << 30, bestLong = 1 << 30;
+        bool found = false;
+        for (const Rect& f : free_) {
+            if (w > f.w || h > f.h) continue;
+            int leftoverW = f.w - w, leftoverH = f.h - h;
+            int shortSide = std::min(leftoverW, leftoverH);
+            int longSide  = std::max(leftoverW, leftoverH);
+            if (shortSide < bestShort || (shortSide == bestShort && longSide < bestLong)) {
+                out = { f.x, f.y, w, h };
+                bestShort = shortSide;
+                bestLong = longSide;
+                found = true;
+            }
+        }
+        if (!found) return false;
+
+        std::vector<Rect> next;
+        for (const Rect& f : free_) split(f, out, next);
+        prune(next);
+        free_.swap(next);
+        return true;
+    }
+
+private:
+    static bool intersects(const Rect& a, const Rect& b) {
+        return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+    }
+
+    static bool contains(const Rect& a, const Rect& b) {
+        return b.x >= a.x && b.y >= a.y && b.x + b.w <= a.x + a.w && b.y + b.h <= a.y + a.h;
+    }
+
+    static void split(const Rect& f, const Rect& used, std::vector<Rect>& out) {
+        if (!intersects(f, used)) { out.push_back(f); return; }
+        if (used.x > f.x)                 out.push_back({ f.x, f.y, used.x - f.x, f.h });
+        if (used.x + used.w < f.x + f.w)  out.push_back({ used.x + used.w, f.y, f.x + f.w - used.x - used.w, f.h });
+        if (used.y > f.y)                 out.push_back({ f.x, f.y, f.w, used.y - f.y });
+        if (used.y + used.h < f.y + f.h)  out.push_back({ f.x, used.y + used.h, f.w, f.y + f.h - used.y - used.h });
+    }
+
+    static void prune(std::vector<Rect>& rects) {
+        for (std::size_t i = 0; i < rects.size(); ++i) {
+            for (std::size_t j = 0; j < rects.size(); ++j) {
+                if (i != j && contains(rects[j], rects[i])) {
+                    rects.erase(rects.begin() + i);
+                    --i;
+                    break;
+                }
+            }
+        }
+    }
+
+    std::vector<Rect> free_;
+};
+
+// Pokusava da spakuje sve preostale sprite-ove u stranu date velicine; vraca koliko je stalo
+static std::size_t packPage(std::vector<Sprite*>& pending, int w, int h, int padding, bool commit, int page) {
+    MaxRectsBin bin(w, h);
+    std::size_t placed = 0;
+    for (Sprite* s : pending) {
+        Rect r;
+        if (!bin.insert(s->trimW + padding * 2, s->trimH + padding * 2, r)) {
+            if (!commit) return placed;
+            continue;
+        }
+        if (commit) {
+            s->page = page;
+            s->placed = { r.x + padding, r.y + padding, s->trimW, s->trimH };
+        }
+        ++placed;
+    }
+    return placed;
+}
+
+struct Page {
+    int w, h;
+    int channels;
+};
+
+// Pakuje grupu sprite-ova u nove strane (dodaju se na kraj pages)
+static void packGroup(std::vector<Sprite*>& pending, int maxSize, int padding, int channels, std::vector<Page>& pages) {
+    std::sort(pending.begin(), pending.end(), [](const Sprite* a, const Sprite* b) {
+        return std::max(a->trimW, a->trimH) > std::max(b->trimW, b->trimH);
+    });
+
+    while (!pending.empty()) {
+        // Strana najmanje povrsine (stranice su umnosci od 64) u koju sve staje;
+        // ako ne staje ni u najvecu, puni se najveca a ostatak ide na sledecu stranu
+        std::vector<Page> candidates;
+        for (int w = 64; w <= maxSize; w += 64)
+            for (int ch = 64; ch <= maxSize; ch += 64)
+                candidates.push_back({ w, ch, channels });
+        std::stable_sort(candidates.begin(), candidates.end(), [](const Page& a, const Page& b) {
+            return a.w * a.h < b.w * b.h;
+        });
+
+        int pw = maxSize, ph = maxSize;
+        std::size_t minArea = 0;
+        for (const Sprite* s : pending)
+            minArea += static_cast<std::size_t>(s->trimW + padding * 2) * (s->trimH + padding * 2);
+        for (const Page& c : candidates) {
+            if (static_cast<std::size_t>(c.w) * c.h < minArea) continue;
+            if (packPage(pending, c.w, c.h, padding, false, 0) == pending.size()) { pw = c.w; ph = c.h; break; }
+        }
+
+        int pageIndex = static_cast<int>(pages.size());
+        packPage(pending, pw, ph, padding, true, pageIndex);
+        pages.push_back({ pw, ph, channels });
+
+        std::vector<Sprite*> rest;
+        for (Sprite* s : pending) if (s->page < 0) rest.push_back(s);
+        pending.swap(rest);
+    }
+}
+
+static void usage() {
+    std::fprintf(stderr,
+        "Upotreba: atlas_packer --out <prefiks> --header <AtlasData.hpp> [--max-size N] [--padding N]\n"
+        "                       [--scale S] slika.png[:scale] ...\n");
+}
+
+int main(int argc, char** argv) {
+    std::string outPrefix, headerPath;
+    int maxSize = 2048;
+    int padding = 2;
+    float defaultScale = 1.0f;
+    std::vector<Sprite> sprites;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--out" && i + 1 < argc)           outPrefix = argv[++i];
+        else if (arg == "--header" && i + 1 < argc)   headerPath = argv[++i];
+        else if (arg == "--max-size" && i + 1 < argc) maxSize = std::atoi(argv[++i]);
+        else if (arg == "--padding" && i + 1 < argc)  padding = std::atoi(argv[++i]);
+        else if (arg == "--scale" && i + 1 < argc)    defaultScale = static_cast<float>(std::atof(argv[++i]));
+        else if (!arg.empty() && arg[0] == '-')       { usage(); return 1; }
+        else {
+            Sprite s;
+            std::string::size_type colon = arg.rfind(':');
+            s.scale = -1.0f;
+            if (colon != std::string::npos) {
+                s.scale = static_cast<float>(std::atof(arg.c_str() + colon + 1));
+                arg.resize(colon);
+            }
+            s.path = arg;
+            s.id = makeIdentifier(arg);
+            s.page = -1;
+            sprites.push_back(s);
+        }
+    }
+
+    if (outPrefix.empty() || headerPath.empty() || sprites.empty()) {
+        usage();
+        return 1;
+    }
+
+    for (Sprite& s : sprites) {
+        if (s.scale <= 0.0f) s.scale = defaultScale;
+        if (!loadSprite(s)) return 1;
+        if (s.trimW + padding * 2 > maxSize || s.trimH + padding * 2 > maxSize) {
+            std::fprintf(stderr, "Slika %s ne staje u stranu %dx%d\n", s.path.c_str(), maxSize, maxSize);
+            return 1;
+        }
+    }
+
+    // RGBA sprite-ovi pa maske; svaka grupa dobija svoje strane
+    std::vector<Page> pages;
+    for (int channels : { 4, 1 }) {
+        std::vector<Sprite*> group;
+        for (Sprite& s : sprites)
+            if (s.mask == (channels == 1)) group.push_back(&s);
+        packGroup(group, maxSize, padding, channels, pages);
+    }
+
+    std::size_t totalBytes = 0;
+    for (std::size_t p = 0; p < pages.size(); ++p) {
+        const int channels = pages[p].channels;
+        std::vector<unsigned char> image(static_cast<std::size_t>(pages[p].w) * pages[p].h * channels, 0);
+        for (const Sprite& s : sprites) {
+            if (s.page != static_cast<int>(p)) continue;
+            for (int y = 0; y < s.trimH; ++y) {
+                const unsigned char* src = s.pixels.data() + static_cast<std::size_t>(y) * s.trimW * 4;
+                unsigned char* dst = image.data() + (static_cast<std::size_t>(s.placed.y + y) * pages[p].w + s.placed.x) * channels;
+                if (channels == 1) extractMaskAlpha(src, s.trimW, dst);
+                else               std::copy(src, src + s.trimW * 4, dst);
+            }
+        }
+        std::string path = outPrefix + std::to_string(p) + ".png";
+        if (!png_writer::writePng(path.c_str(), pages[p].w, pages[p].h, channels, image.data())) {
+            std::fprintf(stderr, "Greska pri upisu %s\n", path.c_str());
+            return 1;
+        }
+        totalBytes += image.size();
+        std::printf("%s: %dx%d, %d kanal(a)\n", path.c_str(), pages[p].w, pages[p].h, channels);
+    }
+
+    std::FILE* h = std::fopen(headerPath.c_str(), "w");
+    if (!h) {
+        std::fprintf(stderr, "Greska pri upisu %s\n", headerPath.c_str());
+        return 1;
+    }
+
+    std::fprintf(h, "#pragma once\n\n");
+    std::fprintf(h, "// Generisano alatom tools/atlas_packer (make atlas) - ne menjati rucno.\n\n");
+    std::fprintf(h, "struct AtlasRegion {\n");
+    std::fprintf(h, "    int page;\n");
+    std::fprintf(h, "    float u0, v0, u1, v1; // UV u atlasu, v = 0 je dno (slike se ucitavaju okrenute)\n");
+    std::fprintf(h, "    float x0, y0, x1, y1; // deo originalne slike koji je ostao posle odsecanja, 0..1\n");
+    std::fprintf(h, "    float r, g, b;        // boja sprite-a na jednokanalnoj strani (maska); 1 na RGBA stranama\n");
+    std::fprintf(h, "};\n\n");
+
+    std::fprintf(h, "enum class SpriteId {\n");
+    for (const Sprite& s : sprites) std::fprintf(h, "    %s,\n", s.id.c_str());
+    std::fprintf(h, "    Count\n};\n\n");
+
+    std::fprintf(h, "static const int kAtlasPageCount = %d;\n\n", static_cast<int>(pages.size()));
+    std::fprintf(h, "static const char* const kAtlasPages[kAtlasPageCount] = {\n");
+    for (std::size_t p = 0; p < pages.size(); ++p)
+        std::fprintf(h, "    \"%s%d.png\",\n", outPrefix.c_str(), static_cast<int>(p));
+    std::fprintf(h, "};\n\n");
+
+    std::fprintf(h, "// 4 = RGBA8, 1 = maska (GL_R8, pokrivenost u crvenom kanalu)\n");
+    std::fprintf(h, "static const int kAtlasPageChannels[kAtlasPageCount] = {");
+    for (std::size_t p = 0; p < pages.size(); ++p)
+        std::fprintf(h, "%s%d", p ? ", " : " ", pages[p].channels);
+    std::fprintf(h, " };\n\n");
+
+    std::fprintf(h, "static const AtlasRegion kAtlasRegions[static_cast<int>(SpriteId::Count)] = {\n");
+    for (const Sprite& s : sprites) {
+        const Page& pg = pages[s.page];
+        float u0 = static_cast<float>(s.placed.x) / pg.w;
+        float u1 = static_cast<float>(s.placed.x + s.trimW) / pg.w;
+        float v0 = 1.0f - static_cast<float>(s.placed.y + s.trimH) / pg.h;
+        float v1 = 1.0f - static_cast<float>(s.placed.y) / pg.h;
+        float x0 = static_cast<float>(s.trimX) / s.srcW;
+        float x1 = static_cast<float>(s.trimX + s.trimW) / s.srcW;
+        float y0 = 1.0f - static_cast<float>(s.trimY + s.trimH) / s.srcH;
+        float y1 = 1.0f - static_cast<float>(s.trimY) / s.srcH;
+        float r = s.mask ? s.color[0] / 255.0f : 1.0f;
+        float g = s.mask ? s.color[1] / 255.0f : 1.0f;
+        float b = s.mask ? s.color[2] / 255.0f : 1.0f;
+        std::fprintf(h, "    { %d, %.6ff, %.6ff, %.6ff, %.6ff, %.6ff, %.6ff, %.6ff, %.6ff, %.6ff, %.6ff, %.6ff }, // %s\n",
+                     s.page, u0, v0, u1, v1, x0, y0, x1, y1, r, g, b, s.path.c_str());
+    }
+    std::fprintf(h, "};\n");
+    std::fclose(h);
+
+    std::size_t masks = 0;
+    for (const Sprite& s : sprites) masks += s.mask ? 1 : 0;
+    std::printf("%zu slika (%zu maski), %zu strana, %.1f KB teksela\n", sprites.size(), masks, pages.size(), totalBytes / 1024.0);
+    return 0;
+}
@@ -0,0 +1,152 @@
+// Offline alat: pravi signed distance field od alfa kanala slike.
+//
+//   sdf_gen [--size 64] [--spread 0.0625] --out <dir> slika.png ...
+//
+// Alfa kanal se binarizuje (prag 128), za svaki piksel se racuna tacna euklidska udaljenost do najblizeg
+// piksela suprotne strane (Felzenszwalb-Huttenlocher EDT, dva 1D prolaza), pa se polje umanji na
+// size x size. Izlaz je jednokanalni PNG istog imena u <dir>: 128 je ivica, vece je unutra.
+// spread je deo sirine izvorne slike koji pokriva opseg 0..255 sa svake strane ivice.
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#include "PngWriter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <string>
+#include <vector>
+
+static const float INF = 1e20f;
+
+// 1D kvadratni EDT donje anvelope parabola; f se prepisuje rezultatom
+static void edt1d(std::vector<float>& f, int n, std::vector<float>& d, std::vector<int>& v, std::vector<float>& z) {
+    int k = 0;
+    v[0] = 0;
+    z[0] = -INF;
+    z[1] = INF;
+    for (int q = 1; q < n; ++q) {
+        float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+        while (s <= z[k]) {
+            --k;
+            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = INF;
+    }
+    k = 0;
+    for (int q = 0; q < n; ++q) {
+        while (z[k + 1] < q) ++k;
+        d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+    for (int q = 0; q < n; ++q) f[q] = d[q];
+}
+
+// Kvadrat udaljenosti svakog piksela do najblizeg piksela za koji je seed == true
+static std::vector<float> edt2d(const std::vector<bool>& seed, int w, int h) {
+    std::vector<float> grid(static_cast<std::size_t>(w) * h);
+    for (std::size_t i = 0; i < grid.size(); ++i) grid[i] = seed[i] ? 0.0f : INF;
+
+    int n = std::max(w, h);
+    std::vector<float> f(n), d(n), z(n + 1);
+    std::vector<int> v(n);
+
+    for (int x = 0; x < w; ++x) {
+        for (int y = 0; y < h; ++y) f[y] = grid[static_cast<std::size_t>(y) * w + x];
+        edt1d(f, h, d, v, z);
+        for (int y = 0; y < h; ++y) grid[static_cast<std::size_t>(y) * w + x] = f[y];
+    }
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) f[x] = grid[static_cast<std::size_t>(y) * w + x];
+        edt1d(f, w, d, v, z);
+        for (int x = 0; x < w; ++x) grid[static_cast<std::size_t>(y) * w + x] = f[x];
+    }
+    return grid;
+}
+
+static float sampleBilinear(const std::vector<float>& field, int w, int h, float x, float y) {
+    x = std::min(std::max(x, 0.0f), static_cast<float>(w - 1));
+    y = std::min(std::max(y, 0.0f), static_cast<float>(h - 1));
+    int x0 = static_cast<int>(x), y0 = static_cast<int>(y);
+    int x1 = std::min(x0 + 1, w - 1), y1 = std::min(y0 + 1, h - 1);
+    float fx = x - x0, fy = y - y0;
+    float a = field[static_cast<std::size_t>(y0) * w + x0] * (1 - fx) + field[static_cast<std::size_t>(y0) * w + x1] * fx;
+    float b = field[static_cast<std::size_t>(y1) * w + x0] * (1 - fx) + field[static_cast<std::size_t>(y1) * w + x1] * fx;
+    return a * (1 - fy) + b * fy;
+}
+
+static bool generate(const std::string& path, const std::string& outDir, int size, float spread) {
+    int w, h, channels;
+    unsigned char* data = stbi_load(path.c_str(), &w, &h, &channels, 4);
+    if (!data) {
+        std::fprintf(stderr, "Slika nije ucitana: %s\n", path.c_str());
+        return false;
+    }
+
+    std::vector<bool> inside(static_cast<std::size_t>(w) * h), outside(static_cast<std::size_t>(w) * h);
+    for (std::size_t i = 0; i < inside.size(); ++i) {
+        inside[i] = data[i * 4 + 3] >= 128;
+        outside[i] = !inside[i];
+    }
+    stbi_image_free(data);
+
+    std::vector<float> toInside = edt2d(inside, w, h);
+    std::vector<float> toOutside = edt2d(outside, w, h);
+
+    // Pozitivno unutra; pomeraj od pola piksela da ivica padne izmedju piksela
+    std::vector<float> field(toInside.size());
+    for (std::size_t i = 0; i < field.size(); ++i)
+        field[i] = (inside[i] ? std::sqrt(toOutside[i]) - 0.5f : 0.5f - std::sqrt(toInside[i]));
+
+    float spreadPx = spread * w;
+    std::vector<unsigned char> out(static_cast<std::size_t>(size) * size);
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            float sx = (x + 0.5f) * w / size - 0.5f;
+            float sy = (y + 0.5f) * h / size - 0.5f;
+            float dist = sampleBilinear(field, w, h, sx, sy);
+            float v = 0.5f + 0.5f * dist / spreadPx;
+            v = std::min(std::max(v, 0.0f), 1.0f);
+            out[static_cast<std::size_t>(y) * size + x] = static_cast<unsigned char>(std::lround(v * 255.0f));
+        }
+    }
+
+    std::string name = path.substr(path.find_last_of("/\\") + 1);
+    std::string outPath = outDir + "/" + name;
+    if (!png_writer::writePng(outPath.c_str(), size, size, 1, out.data())) {
+        std::fprintf(stderr, "Greska pri upisu %s\n", outPath.c_str());
+        return false;
+    }
+    std::printf("%s -> %s (%dx%d)\n", path.c_str(), outPath.c_str(), size, size);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    int size = 64;
+    float spread = 0.0625f;
+    std::string outDir;
+    std::vector<std::string> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--size" && i + 1 < argc)        size = std::atoi(argv[++i]);
+        else if (arg == "--spread" && i + 1 < argc) spread = static_cast<float>(std::atof(argv[++i]));
+        else if (arg == "--out" && i + 1 < argc)    outDir = argv[++i];
+        else if (!arg.empty() && arg[0] == '-')     { outDir.clear(); break; }
+        else inputs.push_back(arg);
+    }
+
+    if (outDir.empty() || inputs.empty() || size <= 0 || spread <= 0.0f) {
+        std::fprintf(stderr, "Upotreba: sdf_gen [--size 64] [--spread 0.0625] --out <dir> slika.png ...\n");
+        return 1;
+    }
+
+    for (const std::string& path : inputs) {
+        if (!generate(path, outDir, size, spread)) return 1;
+    }
+    return 0;
+}
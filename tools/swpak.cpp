@@ -0,0 +1,187 @@
+// Offline alat: pakuje slike u jedan .swpak fajl (format u include/AssetPackFormat.hpp).
+//
+//   swpak --out res/assets.swpak slika.png[:kanali][:mask][:mips] ...
+//
+// kanali je 1 ili 4 (podrazumevano 4); "mips" dodaje ceo mip lanac (box filter, isto kao glGenerateMipmap).
+// "mask": ako je RGBA slika jednobojna, cuva se samo alfa (1 kanal) a boja u unosu (SWPAK_FLAG_MASK).
+// Slike se okrecu unapred, pa runtime salje bajtove iz mmap-a pravo u glTexImage2D bez dekodiranja.
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#include "AssetPackFormat.hpp"
+#include "MaskImage.hpp"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct Input {
+    std::string path;
+    int channels = 4;
+    bool mask = false;
+    bool mips = false;
+};
+
+struct Image {
+    SwpakEntry entry;
+    std::vector<std::vector<unsigned char>> levels;
+};
+
+static bool parseInput(const std::string& arg, Input& outInput) {
+    std::size_t colon = arg.find(':');
+    outInput.path = arg.substr(0, colon);
+    while (colon != std::string::npos) {
+        std::size_t next = arg.find(':', colon + 1);
+        std::string opt = arg.substr(colon + 1, next == std::string::npos ? std::string::npos : next - colon - 1);
+        if (opt == "1" || opt == "4") outInput.channels = std::atoi(opt.c_str());
+        else if (opt == "mask")       outInput.mask = true;
+        else if (opt == "mips")       outInput.mips = true;
+        else return false;
+        colon = next;
+    }
+    return !outInput.path.empty() && outInput.path.size() < SWPAK_MAX_NAME && !(outInput.mask && outInput.channels != 4);
+}
+
+// Jedan mip nivo iz prethodnog: prosek 2x2 bloka (ivice kod neparnih dimenzija se ponavljaju)
+static std::vector<unsigned char> downsample(const std::vector<unsigned char>& src, int w, int h, int channels) {
+    int dw = w > 1 ? w / 2 : 1, dh = h > 1 ? h / 2 : 1;
+    std::vector<unsigned char> dst(static_cast<std::size_t>(dw) * dh * channels);
+    for (int y = 0; y < dh; ++y) {
+        int y0 = std::min(y * 2, h - 1), y1 = std::min(y * 2 + 1, h - 1);
+        for (int x = 0; x < dw; ++x) {
+            int x0 = std::min(x * 2, w - 1), x1 = std::min(x * 2 + 1, w - 1);
+            for (int c = 0; c < channels; ++c) {
+                int sum = src[(static_cast<std::size_t>(y0) * w + x0) * channels + c]
+                        + src[(static_cast<std::size_t>(y0) * w + x1) * channels + c]
+                        + src[(static_cast<std::size_t>(y1) * w + x0) * channels + c]
+                        + src[(static_cast<std::size_t>(y1) * w + x1) * channels + c];
+                dst[(static_cast<std::size_t>(y) * dw + x) * channels + c] = static_cast<unsigned char>((sum + 2) / 4);
+            }
+        }
+    }
+    return dst;
+}
+
+static bool loadImage(const Input& input, Image& outImage) {
+    int w, h, fileChannels;
+    unsigned char* data = stbi_load(input.path.c_str(), &w, &h, &fileChannels, input.channels);
+    if (!data) {
+        std::fprintf(stderr, "Slika nije ucitana: %s\n", input.path.c_str());
+        return false;
+    }
+
+    struct stat st;
+    if (stat(input.path.c_str(), &st) != 0) {
+        stbi_image_free(data);
+        return false;
+    }
+
+    SwpakEntry& e = outImage.entry;
+    std::memset(&e, 0, sizeof(e));
+    std::strncpy(e.name, input.path.c_str(), SWPAK_MAX_NAME - 1);
+
+    int channels = input.channels;
+    unsigned char color[3];
+    if (input.mask && detectMaskColor(data, static_cast<std::size_t>(w) * h, color)) {
+        extractMaskAlpha(data, static_cast<std::size_t>(w) * h, data);
+        channels = 1;
+        e.flags |= SWPAK_FLAG_MASK;
+        std::memcpy(e.maskColor, color, 3);
+    }
+    e.channels = static_cast<std::uint32_t>(channels);
+    e.width = static_cast<std::uint32_t>(w);
+    e.height = static_cast<std::uint32_t>(h);
+    e.sourceSize = static_cast<std::uint64_t>(st.st_size);
+    e.sourceMtime = static_cast<std::int64_t>(st.st_mtime);
+
+    // Okretanje ovde umesto pri svakom pokretanju
+    std::size_t rowSize = static_cast<std::size_t>(w) * channels;
+    std::vector<unsigned char> base(rowSize * h);
+    for (int y = 0; y < h; ++y)
+        std::memcpy(&base[static_cast<std::size_t>(y) * rowSize], data + static_cast<std::size_t>(h - 1 - y) * rowSize, rowSize);
+    stbi_image_free(data);
+
+    outImage.levels.push_back(std::move(base));
+    if (input.mips) {
+        int lw = w, lh = h;
+        while ((lw > 1 || lh > 1) && outImage.levels.size() < static_cast<std::size_t>(SWPAK_MAX_LEVELS)) {
+            outImage.levels.push_back(downsample(outImage.levels.back(), lw, lh, channels));
+            lw = lw > 1 ? lw / 2 : 1;
+            lh = lh > 1 ? lh / 2 : 1;
+        }
+    }
+    e.levels = static_cast<std::uint32_t>(outImage.levels.size());
+    return true;
+}
+
+static std::uint64_t alignUp(std::uint64_t v) {
+    return (v + SWPAK_ALIGNMENT - 1) / SWPAK_ALIGNMENT * SWPAK_ALIGNMENT;
+}
+
+int main(int argc, char** argv) {
+    std::string outPath;
+    std::vector<Input> inputs;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        Input input;
+        if (arg == "--out" && i + 1 < argc)         outPath = argv[++i];
+        else if (!arg.empty() && arg[0] != '-' && parseInput(arg, input)) inputs.push_back(input);
+        else { outPath.clear(); break; }
+    }
+
+    if (outPath.empty() || inputs.empty()) {
+        std::fprintf(stderr, "Upotreba: swpak --out <fajl.swpak> slika.png[:1|:4][:mask][:mips] ...\n");
+        return 1;
+    }
+
+    std::vector<Image> images(inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        if (!loadImage(inputs[i], images[i])) return 1;
+    }
+
+    // Raspored: zaglavlje, tabela unosa, pa nivoi redom
+    std::uint64_t offset = alignUp(sizeof(SwpakHeader) + sizeof(SwpakEntry) * images.size());
+    for (Image& image : images) {
+        for (std::size_t l = 0; l < image.levels.size(); ++l) {
+            image.entry.offset[l] = offset;
+            offset = alignUp(offset + image.levels[l].size());
+        }
+    }
+
+    std::FILE* f = std::fopen(outPath.c_str(), "wb");
+    if (!f) {
+        std::fprintf(stderr, "Greska pri upisu %s\n", outPath.c_str());
+        return 1;
+    }
+
+    SwpakHeader header;
+    std::memcpy(header.magic, SWPAK_MAGIC, 4);
+    header.version = SWPAK_VERSION;
+    header.entryCount = static_cast<std::uint32_t>(images.size());
+    header.reserved = 0;
+    std::fwrite(&header, sizeof(header), 1, f);
+    for (const Image& image : images)
+        std::fwrite(&image.entry, sizeof(SwpakEntry), 1, f);
+
+    static const unsigned char zeros[SWPAK_ALIGNMENT] = {};
+    for (const Image& image : images) {
+        for (std::size_t l = 0; l < image.levels.size(); ++l) {
+            long pos = std::ftell(f);
+            std::fwrite(zeros, 1, static_cast<std::size_t>(image.entry.offset[l] - pos), f);
+            std::fwrite(image.levels[l].data(), 1, image.levels[l].size(), f);
+        }
+        std::printf("%s: %ux%u, %u kanal(a)%s, %u nivo(a)\n", image.entry.name, image.entry.width,
+                    image.entry.height, image.entry.channels,
+                    (image.entry.flags & SWPAK_FLAG_MASK) ? " (maska)" : "", image.entry.levels);
+    }
+
+    std::fclose(f);
+    std::printf("-> %s (%llu bajtova)\n", outPath.c_str(), static_cast<unsigned long long>(offset));
+    return 0;
+}
\ No newline at end of file